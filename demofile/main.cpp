@@ -3,13 +3,39 @@
 #include "StaticArray.h"
 #include "HashSet.h"
 #include "HashMap.h"
+#include "Arena.h"
+#include "ConcurrentArena.h"
+#include "List.h"
+#include "PoolAllocator.h"
+#include "LinearArena.h"
+#include "InlineArena.h"
+#include "SmallArray.h"
+#include "AllocatorRef.h"
+#include "MemoryResource.h"
 
 #include <Log/include/Log.h>
 #include <Log/include/LogPlatform.h>
 
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <new>
 #include <vector>
+#include <list>
 #include <string>
 #include <ostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+
+// Log one check of the tests below, a failure also fires the assert in debug builds
+void Check(const char* name, const bool passed)
+{
+	LOGINFO() << name << " : " << (passed ? "Pass" : "Fail");
+	assert(passed && "A demo check failed");
+}
 
 void HashMapTest()
 {
@@ -454,6 +480,96 @@ void VariantTest()
 	}
 }
 
+// Compare the SIMD search members of an array holding the values against the std algorithms on the same values.
+// The probes cover values present several times, absent values, and a marker kept only in the last element.
+template<typename Array, typename T>
+bool SearchMatchesStd(const Array& arr, const std::vector<T>& expected)
+{
+	bool matches = true;
+
+	for (int probe = -9; probe <= 9; probe++)
+	{
+		const T value = static_cast<T>(probe);
+
+		const auto found = arr.Find(value);
+		const auto expectedFound = std::find(expected.begin(), expected.end(), value);
+		if (expected.end() == expectedFound)
+		{
+			matches = matches && arr.End() == found && !arr.Contains(value);
+		}
+		else
+		{
+			matches = matches && &*found == &arr[static_cast<size_t>(expectedFound - expected.begin())];
+		}
+
+		const auto greater = arr.FindIf(wtr::GreaterThan<T>(value));
+		const auto expectedGreater = std::find_if(expected.begin(), expected.end(), [value](const T item) { return item > value; });
+		if (expected.end() == expectedGreater)
+		{
+			matches = matches && arr.End() == greater;
+		}
+		else
+		{
+			matches = matches && &*greater == &arr[static_cast<size_t>(expectedGreater - expected.begin())];
+		}
+
+		matches = matches && static_cast<size_t>(std::count(expected.begin(), expected.end(), value)) == arr.Count(value);
+		matches = matches && static_cast<size_t>(std::count_if(expected.begin(), expected.end(), [value](const T item) { return item < value; })) == arr.CountIf(wtr::LessThan<T>(value));
+		matches = matches && static_cast<size_t>(std::count_if(expected.begin(), expected.end(), [value](const T item) { return value <= item && item <= static_cast<T>(value + 3); }))
+			== arr.CountIf(wtr::InRange<T>(value, static_cast<T>(value + 3)));
+	}
+
+	if (!expected.empty())
+	{
+		matches = matches && *std::min_element(expected.begin(), expected.end()) == arr.Min();
+		matches = matches && *std::max_element(expected.begin(), expected.end()) == arr.Max();
+	}
+
+	return matches;
+}
+
+// Every size from empty to past the four vector unrolled loop of the widest lanes, so each vector and scalar tail is hit
+template<typename T>
+bool DynamicArraySearchMatchesStd(std::mt19937& random)
+{
+	bool matches = true;
+
+	for (size_t size = 0; size <= 300; size++)
+	{
+		wtr::DynamicArray<T> arr;
+		std::vector<T> expected;
+
+		for (size_t index = 0; index < size; index++)
+		{
+			const T value = (index + 1 == size) ? static_cast<T>(9) : static_cast<T>(static_cast<int>(random() % 16) - 8);
+
+			arr.PushBack(value);
+			expected.push_back(value);
+		}
+
+		matches = matches && SearchMatchesStd(arr, expected);
+	}
+
+	return matches;
+}
+
+template<typename T, size_t N>
+bool StaticArraySearchMatchesStd(std::mt19937& random)
+{
+	wtr::StaticArray<T, N> arr;
+	std::vector<T> expected;
+
+	for (size_t index = 0; index < N; index++)
+	{
+		const T value = (index + 1 == N) ? static_cast<T>(9) : static_cast<T>(static_cast<int>(random() % 16) - 8);
+
+		arr[index] = value;
+		expected.push_back(value);
+	}
+
+	return SearchMatchesStd(arr, expected);
+}
+
 void DynamicArrayTest()
 {
 	LOGINFO() << "[ DynamicArray Test ]";
@@ -608,6 +724,177 @@ void DynamicArrayTest()
 		arr.Clear();
 		LOGINFO() << "Size : " << arr.Size() << " | Empty : " << (arr.Empty() ? "True" : "False");
 	}
+
+	{
+		LOGINFO() << "------ Sort & StableSort Test ------";
+
+		struct Item
+		{
+			int key;
+			int order;
+		};
+
+		auto compareKey = [](const Item& lhs, const Item& rhs) { return lhs.key < rhs.key; };
+
+		std::mt19937 random(42);
+
+		bool sorted = true;
+		bool stable = true;
+		for (const size_t size : { 0, 1, 2, 23, 24, 25, 100, 1000, 50000 })
+		{
+			// Few distinct keys, so the stable order of equal keys is really tested
+			for (const int keyRange : { 4, 1000000 })
+			{
+				wtr::DynamicArray<int> values;
+				wtr::DynamicArray<Item> items;
+				std::vector<int> expectedValues;
+				std::vector<Item> expectedItems;
+
+				for (size_t index = 0; index < size; index++)
+				{
+					const int key = static_cast<int>(random() % keyRange) - keyRange / 2;
+
+					values.PushBack(key);
+					items.PushBack(Item{ key, static_cast<int>(index) });
+					expectedValues.push_back(key);
+					expectedItems.push_back(Item{ key, static_cast<int>(index) });
+				}
+
+				values.Sort();
+				items.StableSort(compareKey);
+				std::sort(expectedValues.begin(), expectedValues.end());
+				std::stable_sort(expectedItems.begin(), expectedItems.end(), compareKey);
+
+				for (size_t index = 0; index < size; index++)
+				{
+					sorted = sorted && expectedValues[index] == values[index];
+					stable = stable && expectedItems[index].key == items[index].key && expectedItems[index].order == items[index].order;
+				}
+			}
+		}
+
+		Check("Sort matches std::sort", sorted);
+		Check("StableSort matches std::stable_sort", stable);
+	}
+
+	{
+		LOGINFO() << "------ RadixSort Test ------";
+
+		std::mt19937 random(7);
+
+		bool integers = true;
+		bool floats = true;
+		for (const size_t size : { 0, 1, 63, 64, 65, 1000, 20000 })
+		{
+			wtr::DynamicArray<int64_t> values;
+			std::vector<int64_t> expectedValues;
+
+			wtr::DynamicArray<float> floatValues;
+			std::vector<float> expectedFloats;
+
+			for (size_t index = 0; index < size; index++)
+			{
+				// Negative keys and keys above 32 bits, so every radix byte and the sign flip are used
+				const int64_t value = (static_cast<int64_t>(random()) << (index % 30)) * ((0 == index % 3) ? -1 : 1);
+				values.PushBack(value);
+				expectedValues.push_back(value);
+
+				// Signed zeros among the floats, the radix key puts -0 before +0
+				const float floatValue = (0 == index % 5) ? ((0 == index % 2) ? 0.0f : -0.0f) : static_cast<float>(static_cast<int>(random() % 2001) - 1000) / 8.0f;
+				floatValues.PushBack(floatValue);
+				expectedFloats.push_back(floatValue);
+			}
+
+			values.RadixSort();
+			floatValues.RadixSort();
+			std::sort(expectedValues.begin(), expectedValues.end());
+			std::stable_sort(expectedFloats.begin(), expectedFloats.end(), [](const float lhs, const float rhs)
+			{
+				return lhs < rhs || (lhs == rhs && std::signbit(lhs) && !std::signbit(rhs));
+			});
+
+			for (size_t index = 0; index < size; index++)
+			{
+				integers = integers && expectedValues[index] == values[index];
+				floats = floats && expectedFloats[index] == floatValues[index] && std::signbit(expectedFloats[index]) == std::signbit(floatValues[index]);
+			}
+		}
+
+		Check("RadixSort matches std::sort on negative 64-bit keys", integers);
+		Check("RadixSort orders floats and signed zeros", floats);
+	}
+
+	{
+		LOGINFO() << "------ ParallelSort Test ------";
+
+		std::mt19937 random(11);
+
+		constexpr size_t SIZE = 200000;
+
+		std::vector<int> expected;
+		for (size_t index = 0; index < SIZE; index++)
+		{
+			expected.push_back(static_cast<int>(random() % 100000));
+		}
+
+		wtr::DynamicArray<int> source;
+		for (const int value : expected)
+		{
+			source.PushBack(value);
+		}
+
+		std::sort(expected.begin(), expected.end());
+
+		bool sorted = true;
+		for (const size_t threadCount : { 1, 2, 3, 5, 7 })
+		{
+			wtr::DynamicArray<int> values = source;
+			values.ParallelSort(std::less<int>(), threadCount);
+
+			for (size_t index = 0; index < SIZE; index++)
+			{
+				sorted = sorted && expected[index] == values[index];
+			}
+		}
+
+		Check("ParallelSort with 1, 2, 3, 5 and 7 threads matches std::sort", sorted);
+	}
+
+	{
+		LOGINFO() << "------ SIMD Search Test ------";
+
+		std::mt19937 random(5);
+
+		Check("int8_t Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<int8_t>(random));
+		Check("uint8_t Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<uint8_t>(random));
+		Check("int16_t Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<int16_t>(random));
+		Check("uint32_t Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<uint32_t>(random));
+		Check("int64_t Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<int64_t>(random));
+		Check("uint64_t Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<uint64_t>(random));
+		Check("float Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<float>(random));
+		Check("double Find / FindIf / Count / CountIf / Min / Max", DynamicArraySearchMatchesStd<double>(random));
+		Check("std::string Find / Count (scalar)", [&]()
+		{
+			wtr::DynamicArray<std::string> arr = { "Apple", "Banana", "Apple" };
+
+			return &*arr.Find("Banana") == &arr[1] && arr.End() == arr.Find("Cherry") && 2 == arr.Count("Apple");
+		}());
+	}
+
+	{
+		LOGINFO() << "------ AppendRange Self Test ------";
+
+		// The array is full, so appending its own items grows the storage they are copied from
+		wtr::DynamicArray<std::string> arr = { "Apple", "Banana", "Cherry" };
+		arr.AppendRange(arr.Begin(), arr.End());
+
+		Check("Iterator range of itself", 6 == arr.Size() && "Apple" == arr[3] && "Banana" == arr[4] && "Cherry" == arr[5]);
+
+		arr.ShrinkToFit();
+		arr.AppendRange(arr.Data() + 1, arr.Data() + 3);
+
+		Check("Pointer range of itself", 8 == arr.Size() && "Banana" == arr[6] && "Cherry" == arr[7]);
+	}
 }
 
 void StaticArrayTest()
@@ -737,6 +1024,632 @@ void StaticArrayTest()
 
 		// constArr[0] = 500; // Compile Error Check
 	}
+
+	{
+		LOGINFO() << "------ SIMD Search Test ------";
+
+		std::mt19937 random(9);
+
+		Check("StaticArray<int8_t, 1>", StaticArraySearchMatchesStd<int8_t, 1>(random));
+		Check("StaticArray<int8_t, 130>", StaticArraySearchMatchesStd<int8_t, 130>(random));
+		Check("StaticArray<uint16_t, 67>", StaticArraySearchMatchesStd<uint16_t, 67>(random));
+		Check("StaticArray<int32_t, 37>", StaticArraySearchMatchesStd<int32_t, 37>(random));
+		Check("StaticArray<int64_t, 19>", StaticArraySearchMatchesStd<int64_t, 19>(random));
+		Check("StaticArray<float, 35>", StaticArraySearchMatchesStd<float, 35>(random));
+		Check("StaticArray<double, 17>", StaticArraySearchMatchesStd<double, 17>(random));
+	}
+}
+
+void ListTest()
+{
+	LOGINFO() << "[ List Test ]";
+
+	{
+		LOGINFO() << "------ Over-aligned Item Test ------";
+
+		struct alignas(64) Block
+		{
+			int value;
+		};
+
+		wtr::List<Block> list;
+		for (int index = 0; index < 16; index++)
+		{
+			list.PushBack(Block{ index });
+		}
+
+		bool aligned = true;
+		bool ordered = true;
+		int expected = 0;
+		for (const auto& block : list)
+		{
+			aligned = aligned && 0 == reinterpret_cast<uintptr_t>(&block) % alignof(Block);
+			ordered = ordered && expected++ == block.value;
+		}
+
+		Check("Size 16", 16 == list.Size());
+		Check("Nodes aligned to 64", aligned);
+		Check("Items in order", ordered);
+	}
+
+	{
+		LOGINFO() << "------ Splice Across Allocators Test ------";
+
+		// Gives out a fixed number of nodes, and is never equal to another, so Splice moves the items one by one
+		struct LimitedAllocator
+		{
+			size_t remaining;
+
+			void* Allocate(const size_t memorySize, const size_t alignSize)
+			{
+				(void)alignSize;
+
+				if (0 == remaining)
+				{
+					return nullptr;
+				}
+
+				remaining--;
+
+				return ::operator new(memorySize, std::nothrow);
+			}
+
+			void Deallocate(void* pointer)
+			{
+				::operator delete(pointer);
+			}
+		};
+
+		wtr::List<std::string, LimitedAllocator> source(LimitedAllocator{ 8 });
+		source.PushBack("Apple");
+		source.PushBack("Banana");
+		source.PushBack("Cherry");
+
+		wtr::List<std::string, LimitedAllocator> target(LimitedAllocator{ 2 });
+		const bool spliced = target.Splice(target.End(), source);
+
+		Check("Splice reports the failed node", !spliced);
+		Check("Moved items kept", 2 == target.Size() && "Apple" == target.Front() && "Banana" == target.Back());
+		Check("Unmoved item left in the source", 1 == source.Size() && "Cherry" == source.Front());
+	}
+}
+
+void LinearArenaTest()
+{
+	LOGINFO() << "[ LinearArena Test ]";
+
+	// Counts its destructor calls, so the tests can see when the arena finalizes it
+	struct Counted
+	{
+		int* counter;
+
+		explicit Counted(int* counter) : counter(counter) {}
+		~Counted() { (*counter)++; }
+	};
+
+	{
+		LOGINFO() << "------ Mark & Rewind Test ------";
+
+		wtr::LinearArena arena(wtr::LinearArena::GrowthPolicy{ 256, 2, 4096 });
+		int destroyed = 0;
+
+		void* kept = arena.Allocate(64);
+		arena.New<Counted>(&destroyed);
+
+		const wtr::LinearArena::Marker marker = arena.Mark();
+		void* first = arena.Allocate(64);
+
+		// Spill over several pages, the rewind must come back to the page of the marker
+		for (int index = 0; index < 32; index++)
+		{
+			arena.Allocate(200);
+			arena.New<Counted>(&destroyed);
+		}
+
+		arena.Rewind(marker);
+
+		Check("Objects after the marker destroyed", 32 == destroyed);
+		Check("Allocation after the rewind reuses the space", first == arena.Allocate(64));
+		Check("Block before the marker kept", nullptr != kept && kept != first);
+
+		arena.Reset();
+
+		Check("Object before the marker destroyed by Reset", 33 == destroyed);
+	}
+
+	{
+		LOGINFO() << "------ Scope Test ------";
+
+		wtr::LinearArena arena;
+		int destroyed = 0;
+
+		void* before = nullptr;
+		{
+			wtr::LinearArena::Scope scope(arena);
+
+			before = arena.Allocate(64);
+			arena.New<Counted>(&destroyed);
+			arena.New<Counted>(&destroyed);
+		}
+
+		Check("Scope destroyed its objects", 2 == destroyed);
+		Check("Scope gave its memory back", before == arena.Allocate(64));
+
+		arena.New<Counted>(&destroyed);
+	}
+
+	{
+		LOGINFO() << "------ New Destructor Test ------";
+
+		int destroyed = 0;
+		{
+			wtr::LinearArena arena;
+
+			Counted* counted = arena.New<Counted>(&destroyed);
+			int* number = arena.New<int>(7);
+
+			Check("New constructs the objects", &destroyed == counted->counter && 7 == *number);
+		}
+
+		Check("Arena destructor finalizes New objects", 1 == destroyed);
+	}
+
+	{
+		LOGINFO() << "------ Reset Coalesce Test ------";
+
+		const size_t blockSize = 200;
+		const size_t blockCount = 10;
+
+		wtr::LinearArena arena(wtr::LinearArena::GrowthPolicy{ 256, 2, 4096 });
+		for (size_t index = 0; index < blockCount; index++)
+		{
+			arena.Allocate(blockSize, 8);
+		}
+
+		// One page as large as the peak usage, so the same workload runs in a single contiguous block
+		arena.Reset(true);
+
+		uint8_t* start = static_cast<uint8_t*>(arena.Allocate(blockSize, 8));
+
+		bool contiguous = nullptr != start;
+		for (size_t index = 1; index < blockCount; index++)
+		{
+			contiguous = contiguous && start + index * blockSize == arena.Allocate(blockSize, 8);
+		}
+
+		Check("Peak usage fits one page after Reset(true)", contiguous);
+	}
+}
+
+void AllocatorTest()
+{
+	LOGINFO() << "[ Allocator Test ]";
+
+	{
+		LOGINFO() << "------ BufferArena Fallback Test ------";
+
+		alignas(std::max_align_t) uint8_t buffer[128];
+		wtr::BufferArena<> arena(buffer, sizeof(buffer));
+
+		void* inside = arena.Allocate(96);
+		void* outside = arena.Allocate(64);
+
+		Check("Block from the buffer", arena.Owns(inside));
+		Check("Block beyond the buffer from the fallback", nullptr != outside && !arena.Owns(outside));
+
+		arena.Deallocate(outside);
+		arena.Deallocate(inside);
+
+		Check("Last buffer block given back", 0 == arena.GetUsedSize());
+
+		wtr::DynamicArray<int, wtr::BufferArena<>> arr(wtr::BufferArena<>(buffer, sizeof(buffer)));
+		arr.Reserve(16);
+
+		const bool wasBuffered = arr.GetAllocator().Owns(arr.Data());
+
+		for (int index = 0; index < 64; index++)
+		{
+			arr.PushBack(index);
+		}
+
+		bool ordered = true;
+		for (int index = 0; index < 64; index++)
+		{
+			ordered = ordered && index == arr[index];
+		}
+
+		Check("Array starts in the buffer", wasBuffered);
+		Check("Array outgrows the buffer", !arr.GetAllocator().Owns(arr.Data()) && ordered);
+	}
+
+	{
+		LOGINFO() << "------ SmallArray Inline Test ------";
+
+		wtr::SmallArray<std::string, 4> small;
+		small.PushBack("Apple");
+
+		Check("Inline with one item", small.IsInline());
+
+		small.PushBack("Banana");
+		small.PushBack("Cherry");
+		small.PushBack("Durian");
+
+		Check("Inline at capacity", small.IsInline() && 4 == small.Capacity());
+
+		wtr::SmallArray<std::string, 4> copied(small);
+
+		Check("Copy keeps its own inline storage", copied.IsInline() && copied.Data() != small.Data() && "Cherry" == copied[2]);
+
+		wtr::SmallArray<std::string, 4> moved(std::move(copied));
+
+		Check("Moved small array stays inline", moved.IsInline() && 4 == moved.Size() && "Durian" == moved[3]);
+
+		small.PushBack("Elder");
+
+		Check("Falls back past capacity", !small.IsInline() && 5 == small.Size() && "Apple" == small[0] && "Elder" == small[4]);
+
+		wtr::SmallArray<std::string, 4> bigCopy(small);
+		wtr::SmallArray<std::string, 4> bigMoved(std::move(small));
+
+		Check("Copy of a large array", 5 == bigCopy.Size() && "Elder" == bigCopy[4] && bigCopy.Data() != bigMoved.Data());
+		Check("Move of a large array", 5 == bigMoved.Size() && "Apple" == bigMoved[0] && !bigMoved.IsInline());
+
+		wtr::SmallArray<std::string, 4> assigned;
+		assigned = moved;
+
+		Check("Copy assign into inline storage", assigned.IsInline() && 4 == assigned.Size() && "Apple" == assigned[0]);
+	}
+
+	{
+		LOGINFO() << "------ AllocatorRef Sharing Test ------";
+
+		wtr::LinearArena arena;
+		const wtr::LinearArena::Marker marker = arena.Mark();
+
+		wtr::DynamicArray<int, wtr::AllocatorRef<wtr::LinearArena>> first((wtr::AllocatorRef<wtr::LinearArena>(arena)));
+		wtr::DynamicArray<int, wtr::AllocatorRef<wtr::LinearArena>> second((wtr::AllocatorRef<wtr::LinearArena>(arena)));
+
+		for (int index = 0; index < 100; index++)
+		{
+			first.PushBack(index);
+			second.PushBack(-index);
+		}
+
+		wtr::DynamicArray<int, wtr::AllocatorRef<wtr::LinearArena>> copied(first);
+
+		Check("Arrays share the arena", &arena == first.GetAllocator().Get() && first.GetAllocator() == second.GetAllocator());
+		Check("Copy shares the arena", &arena == copied.GetAllocator().Get() && 99 == copied[99]);
+		Check("Arena holds the items", arena.Mark().usedSize - marker.usedSize >= 300 * sizeof(int) && -99 == second[99]);
+	}
+
+	{
+		LOGINFO() << "------ Memory Resource Round Trip Test ------";
+
+		wtr::LinearArena arena;
+		wtr::AllocatorResource<wtr::LinearArena> resource(arena);
+		wtr::AllocatorResource<wtr::LinearArena> sameResource(arena);
+
+		// wtr allocator -> std::pmr resource -> wtr container
+		wtr::DynamicArray<std::string, wtr::ResourceAllocator> arr((wtr::ResourceAllocator(&resource)));
+		for (int index = 0; index < 50; index++)
+		{
+			arr.PushBack(std::to_string(index));
+		}
+
+		std::pmr::vector<int> vec(&resource);
+		vec.assign(50, 7);
+
+		void* aligned = arr.GetAllocator().Allocate(100, 64);
+		const bool isAligned = 0 == reinterpret_cast<uintptr_t>(aligned) % 64;
+		arr.GetAllocator().Deallocate(aligned);
+
+		Check("Container items from the arena", 50 == arr.Size() && "49" == arr[49] && 0 != arena.Mark().usedSize);
+		Check("std::pmr container on the arena", 50 == vec.size() && 7 == vec.back());
+		Check("Over-aligned block", isAligned);
+		Check("Resources over one arena compare equal", resource.is_equal(sameResource) && wtr::ResourceAllocator(&resource) == wtr::ResourceAllocator(&sameResource));
+	}
+}
+
+void ArenaBenchmark()
+{
+	LOGINFO() << "[ Arena Benchmark ]";
+
+	{
+		LOGINFO() << "------ Deallocate Cost by Live Blocks ------";
+
+		std::mt19937 random(1234);
+
+		for (size_t count = 10; count <= 1000000; count *= 10)
+		{
+			wtr::Arena arena;
+			std::vector<void*> blockList(count, nullptr);
+
+			for (auto& block : blockList)
+			{
+				block = arena.Allocate(64);
+			}
+
+			// Free in random order, so the cost does not depend on where the block sits in the page list
+			std::shuffle(blockList.begin(), blockList.end(), random);
+
+			const auto start = std::chrono::steady_clock::now();
+			for (auto& block : blockList)
+			{
+				arena.Deallocate(block);
+			}
+			const auto end = std::chrono::steady_clock::now();
+
+			const double totalNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+			LOGINFO() << "Live Blocks : " << count << " | Deallocate : " << totalNs / static_cast<double>(count) << " ns/block";
+		}
+	}
+}
+
+void ConcurrentArenaBenchmark()
+{
+	LOGINFO() << "[ ConcurrentArena Benchmark ]";
+
+	constexpr size_t OPERATION_COUNT = 200000;
+	constexpr size_t BATCH_COUNT = 64;
+
+	// Every thread allocates a batch of mixed size blocks and frees them again
+	auto runWorkers = [](const size_t threadCount, auto&& allocate, auto&& deallocate)
+	{
+		std::vector<std::thread> threadList;
+		threadList.reserve(threadCount);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			threadList.emplace_back([&]()
+			{
+				void* blockList[BATCH_COUNT] = {};
+
+				for (size_t count = 0; count < OPERATION_COUNT; count += BATCH_COUNT)
+				{
+					for (size_t index = 0; index < BATCH_COUNT; index++)
+					{
+						blockList[index] = allocate(16 + (index * 24) % 1024);
+					}
+
+					for (size_t index = 0; index < BATCH_COUNT; index++)
+					{
+						deallocate(blockList[index]);
+					}
+				}
+			});
+		}
+
+		for (auto& thread : threadList)
+		{
+			thread.join();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const double totalMs = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) / 1000.0;
+		const double totalOps = static_cast<double>(threadCount * OPERATION_COUNT);
+
+		return totalOps / totalMs / 1000.0;
+	};
+
+	const size_t maxThreadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+	// 1, 2, 4, ... and the hardware thread count last, even when it is not a power of two
+	size_t threadCount = 1;
+	while (true)
+	{
+		wtr::Arena arena;
+		std::mutex mutex;
+
+		const double lockedRate = runWorkers(threadCount,
+			[&](const size_t size) { std::lock_guard<std::mutex> lock(mutex); return arena.Allocate(size); },
+			[&](void* pointer) { std::lock_guard<std::mutex> lock(mutex); arena.Deallocate(pointer); });
+
+		wtr::ConcurrentArena concurrentArena;
+
+		const double concurrentRate = runWorkers(threadCount,
+			[&](const size_t size) { return concurrentArena.Allocate(size); },
+			[&](void* pointer) { concurrentArena.Deallocate(pointer); });
+
+		LOGINFO() << "Threads : " << threadCount << " | Locked Arena : " << lockedRate << " Mops/s | ConcurrentArena : " << concurrentRate << " Mops/s";
+
+		if (threadCount == maxThreadCount)
+		{
+			break;
+		}
+
+		threadCount = (threadCount * 2 > maxThreadCount) ? maxThreadCount : threadCount * 2;
+	}
+}
+
+// std::list with the wtr names, so the churn loop runs on both
+struct StdList
+{
+	std::list<int> list;
+
+	void PushBack(const int item) { list.push_back(item); }
+	void PushFront(const int item) { list.push_front(item); }
+	void PopBack() { list.pop_back(); }
+	void PopFront() { list.pop_front(); }
+};
+
+void ListBenchmark()
+{
+	LOGINFO() << "[ List Benchmark ]";
+
+	constexpr size_t LIVE_COUNT = 100000;
+	constexpr size_t CHURN_COUNT = 2000000;
+
+	// Keep LIVE_COUNT nodes alive and replace them from both ends, so every insert needs a fresh node
+	auto runChurn = [](auto& list)
+	{
+		for (size_t index = 0; index < LIVE_COUNT; index++)
+		{
+			list.PushBack(static_cast<int>(index));
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t index = 0; index < CHURN_COUNT; index++)
+		{
+			if (0 == (index & 1))
+			{
+				list.PushBack(static_cast<int>(index));
+				list.PopFront();
+			}
+			else
+			{
+				list.PushFront(static_cast<int>(index));
+				list.PopBack();
+			}
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const double totalNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+		return totalNs / static_cast<double>(CHURN_COUNT);
+	};
+
+	LOGINFO() << "------ Insert / Erase Churn ------";
+
+	{
+		StdList list;
+		LOGINFO() << "Global Heap (std::list) : " << runChurn(list) << " ns/op";
+	}
+
+	{
+		wtr::List<int> list;
+		LOGINFO() << "HeapAllocator : " << runChurn(list) << " ns/op";
+	}
+
+	{
+		wtr::List<int, wtr::Arena> list;
+		LOGINFO() << "Arena : " << runChurn(list) << " ns/op";
+	}
+
+	{
+		wtr::List<int, wtr::PoolAllocator<wtr::List<int>::NODE_SIZE>> list;
+		LOGINFO() << "PoolAllocator : " << runChurn(list) << " ns/op";
+	}
+}
+
+void SortBenchmark()
+{
+	LOGINFO() << "[ Sort Benchmark ]";
+
+	constexpr size_t RECORD_COUNT = 1000000;
+
+	struct Record
+	{
+		uint64_t key;
+		uint32_t payload[2];
+	};
+
+	auto compare = [](const Record& lhs, const Record& rhs) { return lhs.key < rhs.key; };
+
+	std::mt19937_64 random(42);
+	wtr::DynamicArray<Record> source;
+	source.Reserve(RECORD_COUNT);
+	for (size_t index = 0; index < RECORD_COUNT; index++)
+	{
+		source.PushBack(Record{ random() % (RECORD_COUNT / 4), { static_cast<uint32_t>(index), 0 } });
+	}
+
+	auto runSort = [&](auto&& sort)
+	{
+		wtr::DynamicArray<Record> records = source;
+
+		const auto start = std::chrono::steady_clock::now();
+		sort(records);
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+	};
+
+	LOGINFO() << "------ Random Keys, " << RECORD_COUNT << " Records ------";
+
+	LOGINFO() << "std::sort : " << runSort([&](wtr::DynamicArray<Record>& records) { std::sort(records.Data(), records.Data() + records.Size(), compare); }) << " ms";
+	LOGINFO() << "DynamicArray::Sort : " << runSort([&](wtr::DynamicArray<Record>& records) { records.Sort(compare); }) << " ms";
+	LOGINFO() << "std::stable_sort : " << runSort([&](wtr::DynamicArray<Record>& records) { std::stable_sort(records.Data(), records.Data() + records.Size(), compare); }) << " ms";
+	LOGINFO() << "DynamicArray::StableSort : " << runSort([&](wtr::DynamicArray<Record>& records) { records.StableSort(compare); }) << " ms";
+
+	LOGINFO() << "DynamicArray::RadixSort : " << runSort([&](wtr::DynamicArray<Record>& records) { records.RadixSort([](const Record& record) { return record.key; }); }) << " ms";
+
+	LOGINFO() << "------ ParallelSort Speedup by Thread Count ------";
+
+	const double sequentialMs = runSort([&](wtr::DynamicArray<Record>& records) { records.Sort(compare); });
+	LOGINFO() << "1 Thread (Sort) : " << sequentialMs << " ms";
+
+	const size_t hardwareCount = std::thread::hardware_concurrency();
+	for (size_t threadCount = 2; threadCount <= 2 * hardwareCount || threadCount <= 8; threadCount *= 2)
+	{
+		const double parallelMs = runSort([&](wtr::DynamicArray<Record>& records) { records.ParallelSort(compare, threadCount); });
+		LOGINFO() << threadCount << " Threads : " << parallelMs << " ms, x" << sequentialMs / parallelMs;
+	}
+}
+
+void SimdBenchmark()
+{
+	LOGINFO() << "[ SIMD Search Benchmark ]";
+
+	constexpr size_t ELEMENT_COUNT = 100000;
+	constexpr size_t REPEAT_COUNT = 2000;
+
+	wtr::DynamicArray<uint32_t> ids;
+	ids.Reserve(ELEMENT_COUNT);
+	for (size_t index = 0; index < ELEMENT_COUNT; index++)
+	{
+		ids.PushBack(static_cast<uint32_t>(index * 2));
+	}
+
+	// Odd ids are never present, so every lookup scans the whole array
+	auto runSearch = [&](auto&& search)
+	{
+		size_t result = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t repeat = 0; repeat < REPEAT_COUNT; repeat++)
+		{
+			result += search(static_cast<uint32_t>(repeat * 2 + 1));
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const double totalNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+		const double bytes = static_cast<double>(sizeof(uint32_t) * ELEMENT_COUNT * REPEAT_COUNT);
+
+		LOGINFO() << "  " << totalNs / REPEAT_COUNT / 1000.0 << " us/scan, " << bytes / totalNs << " GB/s (" << result << ")";
+	};
+
+	LOGINFO() << "------ Find, " << ELEMENT_COUNT << " uint32_t Ids ------";
+
+	LOGINFO() << "Iterator Loop :";
+	runSearch([&](const uint32_t id)
+	{
+		size_t index = 0;
+		for (auto itr = ids.Begin(); itr != ids.End(); itr++, index++)
+		{
+			if (*itr == id)
+			{
+				break;
+			}
+		}
+
+		return index;
+	});
+
+	LOGINFO() << "DynamicArray::Find :";
+	runSearch([&](const uint32_t id) { return static_cast<size_t>(ids.Contains(id)); });
+
+	LOGINFO() << "------ Count / FindIf / Min ------";
+
+	LOGINFO() << "DynamicArray::Count :";
+	runSearch([&](const uint32_t id) { return ids.Count(id); });
+
+	LOGINFO() << "DynamicArray::CountIf (InRange) :";
+	runSearch([&](const uint32_t id) { return ids.CountIf(wtr::InRange<uint32_t>(id, id + 1000)); });
+
+	LOGINFO() << "DynamicArray::Min :";
+	runSearch([&](const uint32_t) { return static_cast<size_t>(ids.Min()); });
 }
 
 int MAIN()
@@ -748,6 +1661,14 @@ int MAIN()
 	VariantTest();
 	DynamicArrayTest();
 	StaticArrayTest();
+	ListTest();
+	LinearArenaTest();
+	AllocatorTest();
+	ArenaBenchmark();
+	ConcurrentArenaBenchmark();
+	ListBenchmark();
+	SortBenchmark();
+	SimdBenchmark();
 
 	system("pause");
 
@@ -0,0 +1,77 @@
+#ifndef __WTR_ALIGNEDALLOCATOR_H__
+#define __WTR_ALIGNEDALLOCATOR_H__
+
+#include <cstddef>
+#include <cassert>
+#include <utility>
+
+#include "Arena.h"
+
+namespace wtr
+{
+	inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+	// Raise every allocation of the wrapped allocator to at least Alignment bytes.
+	// Passing it as a container's allocator, like HashMap<Key, Value, ..., AlignedAllocator<Arena>>,
+	// starts the slot array on a cache line, so it is not shared with other data.
+	template<typename Allocator = Arena, size_t Alignment = CACHE_LINE_SIZE>
+	class AlignedAllocator
+	{
+		static_assert(0 != Alignment && 0 == (Alignment & (Alignment - 1)), "The aligned allocator's alignment must be a power of two");
+
+	public :
+		using AllocatorType = Allocator;
+
+		AlignedAllocator()
+			: m_allocator()
+		{}
+
+		AlignedAllocator(const AlignedAllocator& other) = delete;
+		AlignedAllocator(AlignedAllocator&& other) noexcept
+			: m_allocator(std::move(other.m_allocator))
+		{}
+
+		~AlignedAllocator() = default;
+
+		AlignedAllocator& operator=(const AlignedAllocator& other) = delete;
+		AlignedAllocator& operator=(AlignedAllocator&& other) noexcept
+		{
+			if (this != &other)
+			{
+				m_allocator = std::move(other.m_allocator);
+			}
+
+			return *this;
+		}
+
+	public :
+		void* Allocate(const size_t memorySize, const size_t alignSize = Alignment)
+		{
+			assert(0 != alignSize && 0 == (alignSize & (alignSize - 1)) && "The align size must be a power of two");
+
+			return m_allocator.Allocate(memorySize, alignSize > Alignment ? alignSize : Alignment);
+		}
+
+		void Deallocate(void* pointer)
+		{
+			m_allocator.Deallocate(pointer);
+		}
+
+		template<typename A = Allocator>
+		auto Extend(void* pointer, const size_t newSize) -> decltype(std::declval<A&>().Extend(pointer, newSize))
+		{
+			return m_allocator.Extend(pointer, newSize);
+		}
+
+		template<typename A = Allocator>
+		auto Reallocate(void* pointer, const size_t oldSize, const size_t newSize) -> decltype(std::declval<A&>().Reallocate(pointer, oldSize, newSize))
+		{
+			return m_allocator.Reallocate(pointer, oldSize, newSize);
+		}
+
+	private :
+		Allocator m_allocator;
+	};
+};
+
+#endif // __WTR_ALIGNEDALLOCATOR_H__
\ No newline at end of file
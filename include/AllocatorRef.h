@@ -0,0 +1,84 @@
+#ifndef __WTR_ALLOCATORREF_H__
+#define __WTR_ALLOCATORREF_H__
+
+#include <cstddef>
+#include <cassert>
+#include <utility>
+
+#include "Arena.h"
+
+namespace wtr
+{
+	// Handle to an allocator owned somewhere else, so many containers can draw from one arena.
+	// The allocator must outlive every container using it, and the containers cost one pointer each.
+	template<typename Allocator = Arena>
+	class AllocatorRef
+	{
+	public :
+		using AllocatorType = Allocator;
+
+		AllocatorRef()
+			: m_allocator(nullptr)
+		{}
+
+		AllocatorRef(Allocator& allocator)
+			: m_allocator(&allocator)
+		{}
+
+		AllocatorRef(const AllocatorRef& other) = default;
+		AllocatorRef(AllocatorRef&& other) noexcept = default;
+
+		~AllocatorRef() = default;
+
+		AllocatorRef& operator=(const AllocatorRef& other) = default;
+		AllocatorRef& operator=(AllocatorRef&& other) noexcept = default;
+
+		bool operator==(const AllocatorRef& other) const
+		{
+			return m_allocator == other.m_allocator;
+		}
+
+		bool operator!=(const AllocatorRef& other) const
+		{
+			return !(*this == other);
+		}
+
+	public :
+		void* Allocate(const size_t memorySize, const size_t alignSize = alignof(std::max_align_t))
+		{
+			assert(nullptr != m_allocator && "The allocator reference is empty, failed to allocate");
+
+			return m_allocator->Allocate(memorySize, alignSize);
+		}
+
+		void Deallocate(void* pointer)
+		{
+			if (nullptr != m_allocator)
+			{
+				m_allocator->Deallocate(pointer);
+			}
+		}
+
+		template<typename A = Allocator>
+		auto Extend(void* pointer, const size_t newSize) -> decltype(std::declval<A&>().Extend(pointer, newSize))
+		{
+			return m_allocator->Extend(pointer, newSize);
+		}
+
+		template<typename A = Allocator>
+		auto Reallocate(void* pointer, const size_t oldSize, const size_t newSize) -> decltype(std::declval<A&>().Reallocate(pointer, oldSize, newSize))
+		{
+			return m_allocator->Reallocate(pointer, oldSize, newSize);
+		}
+
+		Allocator* Get() const
+		{
+			return m_allocator;
+		}
+
+	private :
+		Allocator* m_allocator;
+	};
+};
+
+#endif // __WTR_ALLOCATORREF_H__
\ No newline at end of file
@@ -2,50 +2,91 @@
 #define __WTR_ARENA_H__
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <new>
 
+#if defined(__unix__) || defined(__APPLE__)
+	#include <sys/mman.h>
+	#include <unistd.h>
+
+	#define WTR_ARENA_USE_MMAP 1
+#else
+	#define WTR_ARENA_USE_MMAP 0
+#endif
+
 namespace wtr
 {
 	class Arena
 	{
 		private :
-			struct Page
+			// The page header is placed right before the memory returned to the user,
+			// so the header of any allocation can be found in constant time.
+			// The word right before the user's memory always holds its distance from the header,
+			// which is the header's own offset field unless the block was padded for alignment.
+			struct alignas(std::max_align_t) Page
 			{
 				Page* next;
 				Page* prev;
-				void* data;
+				size_t size;
+				size_t mapSize;
+				size_t alignSize;
+				size_t offset;
 
 				Page()
 					: next(nullptr)
 					, prev(nullptr)
-					, data(nullptr)
+					, size(0)
+					, mapSize(0)
+					, alignSize(alignof(Page))
+					, offset(sizeof(Page))
 				{}
 
 				~Page() = default;
 			};
 
+			static_assert(offsetof(Page, offset) + sizeof(size_t) == sizeof(Page), "The page's offset must be the last word before the user's memory");
+
+			// Blocks up to MAX_CLASS_SIZE are rounded up to a power of two size class,
+			// and are kept in the class's free list after Deallocate for reuse.
+			static constexpr size_t MIN_CLASS_SIZE = 16;
+			static constexpr size_t MAX_CLASS_SIZE = 256 * 1024;
+			static constexpr size_t CLASS_COUNT = 15;
+
+			static_assert((MIN_CLASS_SIZE << (CLASS_COUNT - 1)) == MAX_CLASS_SIZE, "The arena's size classes must end at the max class size");
+
+			static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
 		public :
+			// Blocks above the size classes and at least mapThreshold bytes large are mapped directly from the system.
+			// useHugePage asks for transparent huge pages, prefault touches every page up front instead of on first use.
+			struct Options
+			{
+				size_t mapThreshold = 1024 * 1024;
+				bool useHugePage = false;
+				bool prefault = false;
+			};
+
 			Arena()
 				: m_end()
+				, m_freeList()
+				, m_options()
 			{
 				m_end.prev = &m_end;
 				m_end.next = &m_end;
 			}
 
+			explicit Arena(const Options& options)
+				: Arena()
+			{
+				m_options = options;
+			}
+
 			Arena(const Arena& other) = delete;
 			Arena(Arena&& other) noexcept
 				: Arena()
 			{
-				if (other.m_end.next != &other.m_end)
-				{
-					m_end.next = other.m_end.next;
-					m_end.prev = other.m_end.prev;
-					m_end.next->prev = &m_end;
-					m_end.prev->next = &m_end;
-
-					other.m_end.next = &other.m_end;
-					other.m_end.prev = &other.m_end;
-				}
+				Steal(other);
 			}
 
 			~Arena()
@@ -56,47 +97,59 @@ namespace wtr
 			Arena& operator=(const Arena& other) = delete;
 			Arena& operator=(Arena&& other) noexcept
 			{
-				if (this != &other && other.m_end.next != &other.m_end)
+				if (this != &other)
 				{
 					Release();
-
-					m_end.next = other.m_end.next;
-					m_end.prev = other.m_end.prev;
-					m_end.next->prev = &m_end;
-					m_end.prev->next = &m_end;
-
-					other.m_end.next = &other.m_end;
-					other.m_end.prev = &other.m_end;
+					Steal(other);
 				}
 
 				return *this;
 			}
 
 		public :
-			void* Allocate(const size_t memorySize)
+			void* Allocate(const size_t memorySize, const size_t alignSize = alignof(std::max_align_t))
 			{
-				const size_t alignSize = alignof(Page);
-				const size_t paddingSize = (alignSize - (memorySize % alignSize)) % alignSize;
-				const size_t offsetSize = memorySize + paddingSize;
-				const size_t totalSize = offsetSize + sizeof(Page);
+				const size_t blockAlignSize = alignSize > alignof(Page) ? alignSize : alignof(Page);
+				const size_t totalSize = memorySize + (blockAlignSize - alignof(Page));
 
-				void* memory = ::operator new(totalSize, std::nothrow);
-				if (nullptr == memory)
+				Page* newPage = nullptr;
+
+				if (totalSize <= MAX_CLASS_SIZE)
+				{
+					const size_t classIndex = GetClassIndex(totalSize);
+
+					newPage = m_freeList[classIndex];
+					if (nullptr != newPage)
+					{
+						m_freeList[classIndex] = newPage->next;
+					}
+					else
+					{
+						newPage = CreatePage(MIN_CLASS_SIZE << classIndex);
+					}
+				}
+				else if (totalSize >= m_options.mapThreshold)
+				{
+					newPage = MapPage(totalSize);
+				}
+				else
+				{
+					newPage = CreatePage(totalSize);
+				}
+
+				if (nullptr == newPage)
 				{
 					return nullptr;
 				}
 
-				void* pageOffset = static_cast<void*>(static_cast<uint8_t*>(memory) + offsetSize);
-				
-				Page* newPage = new (pageOffset) Page();
-				newPage->data = memory;
+				newPage->alignSize = blockAlignSize;
 
 				m_end.prev->next = newPage;
 				newPage->prev = m_end.prev;
 				newPage->next = &m_end;
 				m_end.prev = newPage;
 
-				return memory;
+				return PlaceData(newPage);
 			}
 
 			void Deallocate(void* pointer)
@@ -106,29 +159,137 @@ namespace wtr
 					return;
 				}
 
-				Page* now = m_end.next;
-				while (nullptr != now && &m_end != now)
+				Page* page = GetPage(pointer);
+				Page* prev = page->prev;
+				Page* next = page->next;
+
+				prev->next = next;
+				next->prev = prev;
+
+				if (page->size <= MAX_CLASS_SIZE)
 				{
-					Page* prev = now->prev;
-					Page* next = now->next;
+					const size_t classIndex = GetClassIndex(page->size);
+
+					page->prev = nullptr;
+					page->next = m_freeList[classIndex];
+					m_freeList[classIndex] = page;
+				}
+				else
+				{
+					DestroyPage(page);
+				}
+			}
+
+			// Grow the block in place, succeeds when the block's size class already covers the new size,
+			// or when a mapped block's following address range is still free.
+			// Every other block is its own heap allocation with no neighbour to merge into, so growing past
+			// the power of two class (as a doubling DynamicArray always does) fails until the block is mapped.
+			bool Extend(void* pointer, const size_t newSize)
+			{
+				if (nullptr == pointer)
+				{
+					return false;
+				}
+
+				Page* page = GetPage(pointer);
+				const size_t paddingSize = static_cast<size_t>(static_cast<uint8_t*>(pointer) - static_cast<uint8_t*>(GetData(page)));
+				if (newSize + paddingSize <= page->size)
+				{
+					return true;
+				}
+
+#if WTR_ARENA_USE_MMAP && defined(MREMAP_MAYMOVE)
+				if (0 != page->mapSize)
+				{
+					const size_t newMapSize = AlignUp(sizeof(Page) + paddingSize + newSize, GetMapAlignSize());
 
-					if (pointer == now->data)
+					void* memory = ::mremap(static_cast<void*>(page), page->mapSize, newMapSize, 0);
+					if (MAP_FAILED != memory)
 					{
-						now->~Page();
+						page->size = newMapSize - sizeof(Page);
+						page->mapSize = newMapSize;
+
+						if (m_options.useHugePage)
+						{
+							AdviseHugePage(memory, newMapSize);
+						}
+
+						return true;
+					}
+				}
+#endif
+
+				return false;
+			}
+
+			// Only the first oldSize bytes are kept when the block has to move,
+			// and the old block stays valid when the new one can not be allocated.
+			// Below the map threshold a move is a fresh block plus one memcpy, mapped blocks move through mremap without a copy.
+			// The moved block keeps the alignment it was allocated with.
+			void* Reallocate(void* pointer, const size_t oldSize, const size_t newSize)
+			{
+				if (nullptr == pointer)
+				{
+					return Allocate(newSize);
+				}
+
+				if (Extend(pointer, newSize))
+				{
+					return pointer;
+				}
+
+				Page* page = GetPage(pointer);
+
+#if WTR_ARENA_USE_MMAP && defined(MREMAP_MAYMOVE)
+				if (0 != page->mapSize && page->alignSize <= GetSystemPageSize() && newSize >= m_options.mapThreshold)
+				{
+					return RemapPage(page, pointer, newSize);
+				}
+#endif
+
+				void* memory = Allocate(newSize, page->alignSize);
+				if (nullptr == memory)
+				{
+					return nullptr;
+				}
 
-						::operator delete(pointer);
+				std::memcpy(memory, pointer, oldSize < newSize ? oldSize : newSize);
 
-						prev->next = next;
-						next->prev = prev;
+				Deallocate(pointer);
 
-						return;
+				return memory;
+			}
+
+			const Options& GetOptions() const
+			{
+				return m_options;
+			}
+
+			void SetOptions(const Options& options)
+			{
+				m_options = options;
+			}
+
+			// Return every cached free block to the system, live blocks are untouched
+			void Trim()
+			{
+				for (auto& freeList : m_freeList)
+				{
+					Page* now = freeList;
+					while (nullptr != now)
+					{
+						Page* next = now->next;
+
+						DestroyPage(now);
+
+						now = next;
 					}
 
-					now = next;
+					freeList = nullptr;
 				}
 			}
 
-		private :
+			// Free every block at once, containers using the arena must not touch their memory afterwards
 			void Release()
 			{
 				Page* now = m_end.next;
@@ -136,18 +297,282 @@ namespace wtr
 				{
 					Page* next = now->next;
 
-					if (nullptr != now->data)
+					DestroyPage(now);
+
+					now = next;
+				}
+
+				m_end.next = &m_end;
+				m_end.prev = &m_end;
+
+				Trim();
+			}
+
+		private :
+			static size_t GetClassIndex(const size_t memorySize)
+			{
+				size_t classIndex = 0;
+				while ((MIN_CLASS_SIZE << classIndex) < memorySize)
+				{
+					classIndex++;
+				}
+
+				return classIndex;
+			}
+
+			static Page* CreatePage(const size_t memorySize)
+			{
+				const size_t totalSize = sizeof(Page) + memorySize;
+
+				void* memory = ::operator new(totalSize, std::nothrow);
+				if (nullptr == memory)
+				{
+					return nullptr;
+				}
+
+				Page* newPage = new (memory) Page();
+				newPage->size = memorySize;
+
+				return newPage;
+			}
+
+			static void DestroyPage(Page* page)
+			{
+				const size_t mapSize = page->mapSize;
+
+				page->~Page();
+
+				if (0 != mapSize)
+				{
+#if WTR_ARENA_USE_MMAP
+					::munmap(static_cast<void*>(page), mapSize);
+#endif
+				}
+				else
+				{
+					::operator delete(static_cast<void*>(page));
+				}
+			}
+
+			static size_t AlignUp(const size_t memorySize, const size_t alignSize)
+			{
+				return (memorySize + alignSize - 1) / alignSize * alignSize;
+			}
+
+			static size_t GetSystemPageSize()
+			{
+#if WTR_ARENA_USE_MMAP
+				static const size_t s_pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+				return s_pageSize;
+#else
+				return 4096;
+#endif
+			}
+
+			static Page* GetPage(void* pointer)
+			{
+				const size_t offset = *(static_cast<size_t*>(pointer) - 1);
+
+				return reinterpret_cast<Page*>(static_cast<uint8_t*>(pointer) - offset);
+			}
+
+			static void* GetData(Page* page)
+			{
+				return static_cast<void*>(reinterpret_cast<uint8_t*>(page) + sizeof(Page));
+			}
+
+			static void* PlaceData(Page* page)
+			{
+				uint8_t* data = static_cast<uint8_t*>(GetData(page));
+				uint8_t* alignedData = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<uintptr_t>(data), page->alignSize));
+
+				if (alignedData != data)
+				{
+					*(reinterpret_cast<size_t*>(alignedData) - 1) = static_cast<size_t>(alignedData - reinterpret_cast<uint8_t*>(page));
+				}
+
+				return static_cast<void*>(alignedData);
+			}
+
+		private :
+			size_t GetMapAlignSize() const
+			{
+				return m_options.useHugePage ? HUGE_PAGE_SIZE : GetSystemPageSize();
+			}
+
+#if WTR_ARENA_USE_MMAP
+			// Over map by one huge page and cut the ends, so the mapping starts on a huge page boundary
+			static void* MapHugeAligned(const size_t mapSize, const int flags)
+			{
+				void* reserved = ::mmap(nullptr, mapSize + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, flags, -1, 0);
+				if (MAP_FAILED == reserved)
+				{
+					return nullptr;
+				}
+
+				const uintptr_t reservedStart = reinterpret_cast<uintptr_t>(reserved);
+				const uintptr_t alignedStart = AlignUp(reservedStart, HUGE_PAGE_SIZE);
+				const size_t headSize = alignedStart - reservedStart;
+				const size_t tailSize = HUGE_PAGE_SIZE - headSize;
+
+				if (0 != headSize)
+				{
+					::munmap(reserved, headSize);
+				}
+
+				if (0 != tailSize)
+				{
+					::munmap(reinterpret_cast<void*>(alignedStart + mapSize), tailSize);
+				}
+
+				return reinterpret_cast<void*>(alignedStart);
+			}
+
+			static void AdviseHugePage(void* memory, const size_t mapSize)
+			{
+#if defined(MADV_HUGEPAGE)
+				::madvise(memory, mapSize, MADV_HUGEPAGE);
+#else
+				(void)memory;
+				(void)mapSize;
+#endif
+			}
+#endif
+
+			Page* MapPage(const size_t memorySize) const
+			{
+#if WTR_ARENA_USE_MMAP
+				const size_t pageSize = GetSystemPageSize();
+				const size_t alignSize = m_options.useHugePage ? HUGE_PAGE_SIZE : pageSize;
+				const size_t mapSize = AlignUp(sizeof(Page) + memorySize, alignSize);
+
+				int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+				const bool populate = m_options.prefault && !m_options.useHugePage;
+				if (populate)
+				{
+					flags |= MAP_POPULATE;
+				}
+#else
+				const bool populate = false;
+#endif
+
+				void* memory = nullptr;
+
+				if (m_options.useHugePage)
+				{
+					memory = MapHugeAligned(mapSize, flags);
+					if (nullptr == memory)
 					{
-						now->~Page();
-						::operator delete(now->data);
+						return nullptr;
 					}
 
-					now = next;
+					AdviseHugePage(memory, mapSize);
+				}
+				else
+				{
+					memory = ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+					if (MAP_FAILED == memory)
+					{
+						return nullptr;
+					}
+				}
+
+				if (m_options.prefault && !populate)
+				{
+					volatile uint8_t* bytes = static_cast<volatile uint8_t*>(memory);
+					for (size_t offset = 0; offset < mapSize; offset += pageSize)
+					{
+						bytes[offset] = 0;
+					}
+				}
+
+				Page* newPage = new (memory) Page();
+				newPage->size = mapSize - sizeof(Page);
+				newPage->mapSize = mapSize;
+
+				return newPage;
+#else
+				return CreatePage(memorySize);
+#endif
+			}
+
+#if WTR_ARENA_USE_MMAP && defined(MREMAP_MAYMOVE)
+			// A huge page mapping is moved onto a fresh huge page boundary, since mremap alone only keeps the system page alignment
+			void* RemapPage(Page* page, void* pointer, const size_t newSize)
+			{
+				const size_t offset = static_cast<size_t>(static_cast<uint8_t*>(pointer) - reinterpret_cast<uint8_t*>(page));
+				const size_t newMapSize = AlignUp(offset + newSize, GetMapAlignSize());
+
+				void* memory = MAP_FAILED;
+
+#if defined(MREMAP_FIXED)
+				if (m_options.useHugePage)
+				{
+					void* target = MapHugeAligned(newMapSize, MAP_PRIVATE | MAP_ANONYMOUS);
+					if (nullptr != target)
+					{
+						memory = ::mremap(static_cast<void*>(page), page->mapSize, newMapSize, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+						if (MAP_FAILED == memory)
+						{
+							::munmap(target, newMapSize);
+						}
+					}
+				}
+#endif
+
+				if (MAP_FAILED == memory)
+				{
+					memory = ::mremap(static_cast<void*>(page), page->mapSize, newMapSize, MREMAP_MAYMOVE);
+					if (MAP_FAILED == memory)
+					{
+						return nullptr;
+					}
+				}
+
+				if (m_options.useHugePage)
+				{
+					AdviseHugePage(memory, newMapSize);
+				}
+
+				Page* newPage = static_cast<Page*>(memory);
+				newPage->size = newMapSize - sizeof(Page);
+				newPage->mapSize = newMapSize;
+				newPage->prev->next = newPage;
+				newPage->next->prev = newPage;
+
+				return static_cast<void*>(reinterpret_cast<uint8_t*>(newPage) + offset);
+			}
+#endif
+
+			void Steal(Arena& other)
+			{
+				if (other.m_end.next != &other.m_end)
+				{
+					m_end.next = other.m_end.next;
+					m_end.prev = other.m_end.prev;
+					m_end.next->prev = &m_end;
+					m_end.prev->next = &m_end;
+
+					other.m_end.next = &other.m_end;
+					other.m_end.prev = &other.m_end;
 				}
+
+				for (size_t classIndex = 0; classIndex < CLASS_COUNT; classIndex++)
+				{
+					m_freeList[classIndex] = other.m_freeList[classIndex];
+					other.m_freeList[classIndex] = nullptr;
+				}
+
+				m_options = other.m_options;
 			}
 
 		private :
 			Page m_end;
+			Page* m_freeList[CLASS_COUNT];
+
+			Options m_options;
 	};
 };
 
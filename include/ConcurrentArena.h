@@ -0,0 +1,597 @@
+#ifndef __WTR_CONCURRENTARENA_H__
+#define __WTR_CONCURRENTARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace wtr
+{
+	// Arena which can be shared by many threads.
+	// Every thread allocates from its own cache, so Allocate never takes a lock after the thread's first call.
+	// A block freed by another thread is pushed on the owner cache's remote list, and the owner takes the whole list back on its next Allocate.
+	// A thread remembers its caches for the last BINDING_COUNT arenas it used, a thread cycling through more
+	// arenas than that takes the arena's lock to find its cache again on every miss.
+	// When a thread exits its cache frees every cached block and becomes an orphan: blocks still live in it are freed
+	// straight to the system by whichever thread releases them, and the next new thread adopts the cache.
+	// A thread must not allocate from the arena from its own thread_local destructors.
+	class ConcurrentArena
+	{
+		private :
+			struct Cache;
+
+			struct alignas(std::max_align_t) Page
+			{
+				Page* next;
+				Page* prev;
+				Cache* owner;
+				size_t size;
+				size_t alignSize;
+				size_t offset;
+
+				Page()
+					: next(nullptr)
+					, prev(nullptr)
+					, owner(nullptr)
+					, size(0)
+					, alignSize(alignof(Page))
+					, offset(sizeof(Page))
+				{}
+
+				~Page() = default;
+			};
+
+			static_assert(offsetof(Page, offset) + sizeof(size_t) == sizeof(Page), "The page's offset must be the last word before the user's memory");
+
+			static constexpr size_t MIN_CLASS_SIZE = 16;
+			static constexpr size_t MAX_CLASS_SIZE = 256 * 1024;
+			static constexpr size_t CLASS_COUNT = 15;
+
+			static_assert((MIN_CLASS_SIZE << (CLASS_COUNT - 1)) == MAX_CLASS_SIZE, "The arena's size classes must end at the max class size");
+
+			// The page list and the free lists are only touched by the owner thread, or under the mutex once the cache is orphaned.
+			// The cache is shared by the arena and its owner thread, and whichever lets go of it last deletes it.
+			struct Cache
+			{
+				Page end;
+				Page* freeList[CLASS_COUNT];
+				std::atomic<Page*> remoteList;
+
+				std::atomic<std::thread::id> threadId;
+				std::atomic<bool> orphaned;
+				std::atomic<bool> trimRequest;
+				std::atomic<uint32_t> refCount;
+				std::mutex mutex;
+
+				Cache* next;
+				Cache* threadNext;
+
+				Cache()
+					: end()
+					, freeList()
+					, remoteList(nullptr)
+					, threadId(std::this_thread::get_id())
+					, orphaned(false)
+					, trimRequest(false)
+					, refCount(2)
+					, mutex()
+					, next(nullptr)
+					, threadNext(nullptr)
+				{
+					end.prev = &end;
+					end.next = &end;
+				}
+			};
+
+			// Caches the thread owns across every arena, orphaned when the thread exits
+			struct ThreadCacheList
+			{
+				Cache* head = nullptr;
+
+				~ThreadCacheList()
+				{
+					Cache* cache = head;
+					while (nullptr != cache)
+					{
+						Cache* nextCache = cache->threadNext;
+
+						Orphan(cache);
+
+						cache = nextCache;
+					}
+				}
+			};
+
+			struct Binding
+			{
+				uint64_t arenaId;
+				Cache* cache;
+			};
+
+			static constexpr size_t BINDING_COUNT = 8;
+
+		public :
+			ConcurrentArena()
+				: m_id(s_nextId.fetch_add(1, std::memory_order_relaxed) + 1)
+				, m_cacheList(nullptr)
+				, m_mutex()
+			{}
+
+			ConcurrentArena(const ConcurrentArena& other) = delete;
+			ConcurrentArena(ConcurrentArena&& other) = delete;
+
+			// Every thread must be done with the arena before it is destroyed
+			~ConcurrentArena()
+			{
+				Release();
+			}
+
+			ConcurrentArena& operator=(const ConcurrentArena& other) = delete;
+			ConcurrentArena& operator=(ConcurrentArena&& other) = delete;
+
+		public :
+			void* Allocate(const size_t memorySize, const size_t alignSize = alignof(std::max_align_t))
+			{
+				const size_t blockAlignSize = alignSize > alignof(Page) ? alignSize : alignof(Page);
+				const size_t totalSize = memorySize + (blockAlignSize - alignof(Page));
+
+				Cache* cache = GetCache();
+				if (nullptr == cache)
+				{
+					return nullptr;
+				}
+
+				if (nullptr != cache->remoteList.load(std::memory_order_relaxed))
+				{
+					Reclaim(cache);
+				}
+
+				if (cache->trimRequest.load(std::memory_order_relaxed))
+				{
+					cache->trimRequest.store(false, std::memory_order_relaxed);
+					TrimCache(cache);
+				}
+
+				Page* newPage = nullptr;
+
+				if (totalSize <= MAX_CLASS_SIZE)
+				{
+					const size_t classIndex = GetClassIndex(totalSize);
+
+					newPage = cache->freeList[classIndex];
+					if (nullptr != newPage)
+					{
+						cache->freeList[classIndex] = newPage->next;
+					}
+					else
+					{
+						newPage = CreatePage(MIN_CLASS_SIZE << classIndex);
+					}
+				}
+				else
+				{
+					newPage = CreatePage(totalSize);
+				}
+
+				if (nullptr == newPage)
+				{
+					return nullptr;
+				}
+
+				newPage->owner = cache;
+				newPage->alignSize = blockAlignSize;
+
+				cache->end.prev->next = newPage;
+				newPage->prev = cache->end.prev;
+				newPage->next = &cache->end;
+				cache->end.prev = newPage;
+
+				return PlaceData(newPage);
+			}
+
+			void Deallocate(void* pointer)
+			{
+				if (nullptr == pointer)
+				{
+					return;
+				}
+
+				Page* page = GetPage(pointer);
+				Cache* owner = page->owner;
+
+				if (owner->threadId.load(std::memory_order_relaxed) == std::this_thread::get_id())
+				{
+					Recycle(owner, page);
+				}
+				else
+				{
+					// The block's memory is dead, so its first word links the remote list
+					Page** link = static_cast<Page**>(GetData(page));
+					Page* head = owner->remoteList.load(std::memory_order_relaxed);
+					do
+					{
+						*link = head;
+					} while (!owner->remoteList.compare_exchange_weak(head, page, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+					// Either the exiting owner's drain sees this push, or this load sees the orphan flag, never neither
+					if (owner->orphaned.load(std::memory_order_seq_cst))
+					{
+						std::lock_guard<std::mutex> lock(owner->mutex);
+
+						if (owner->orphaned.load(std::memory_order_relaxed))
+						{
+							DrainOrphan(owner);
+						}
+					}
+				}
+			}
+
+			// Return the calling thread's cached free blocks, and the blocks freed into orphaned caches, to the system.
+			// Every other thread returns its own cached blocks on its next Allocate.
+			void Trim()
+			{
+				Cache* cache = FindCache();
+				if (nullptr != cache)
+				{
+					Reclaim(cache);
+					TrimCache(cache);
+				}
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				Cache* now = m_cacheList;
+				while (nullptr != now)
+				{
+					if (now != cache)
+					{
+						if (now->orphaned.load(std::memory_order_acquire))
+						{
+							std::lock_guard<std::mutex> cacheLock(now->mutex);
+
+							if (now->orphaned.load(std::memory_order_relaxed))
+							{
+								DrainOrphan(now);
+							}
+						}
+						else
+						{
+							now->trimRequest.store(true, std::memory_order_relaxed);
+						}
+					}
+
+					now = now->next;
+				}
+			}
+
+		private :
+			static size_t GetClassIndex(const size_t memorySize)
+			{
+				size_t classIndex = 0;
+				while ((MIN_CLASS_SIZE << classIndex) < memorySize)
+				{
+					classIndex++;
+				}
+
+				return classIndex;
+			}
+
+			static Page* CreatePage(const size_t memorySize)
+			{
+				const size_t totalSize = sizeof(Page) + memorySize;
+
+				void* memory = ::operator new(totalSize, std::nothrow);
+				if (nullptr == memory)
+				{
+					return nullptr;
+				}
+
+				Page* newPage = new (memory) Page();
+				newPage->size = memorySize;
+
+				return newPage;
+			}
+
+			static void DestroyPage(Page* page)
+			{
+				page->~Page();
+
+				::operator delete(static_cast<void*>(page));
+			}
+
+			static Page* GetPage(void* pointer)
+			{
+				const size_t offset = *(static_cast<size_t*>(pointer) - 1);
+
+				return reinterpret_cast<Page*>(static_cast<uint8_t*>(pointer) - offset);
+			}
+
+			static void* GetData(Page* page)
+			{
+				return static_cast<void*>(reinterpret_cast<uint8_t*>(page) + sizeof(Page));
+			}
+
+			static void* PlaceData(Page* page)
+			{
+				const uintptr_t data = reinterpret_cast<uintptr_t>(GetData(page));
+				const uintptr_t alignedData = (data + page->alignSize - 1) / page->alignSize * page->alignSize;
+
+				if (alignedData != data)
+				{
+					*(reinterpret_cast<size_t*>(alignedData) - 1) = static_cast<size_t>(alignedData - reinterpret_cast<uintptr_t>(page));
+				}
+
+				return reinterpret_cast<void*>(alignedData);
+			}
+
+			static void Unlink(Page* page)
+			{
+				Page* prev = page->prev;
+				Page* next = page->next;
+
+				prev->next = next;
+				next->prev = prev;
+			}
+
+			static void Recycle(Cache* cache, Page* page)
+			{
+				Unlink(page);
+
+				if (page->size <= MAX_CLASS_SIZE)
+				{
+					const size_t classIndex = GetClassIndex(page->size);
+
+					page->prev = nullptr;
+					page->next = cache->freeList[classIndex];
+					cache->freeList[classIndex] = page;
+				}
+				else
+				{
+					DestroyPage(page);
+				}
+			}
+
+			static void Reclaim(Cache* cache)
+			{
+				Page* now = cache->remoteList.exchange(nullptr, std::memory_order_acquire);
+				while (nullptr != now)
+				{
+					Page* next = *static_cast<Page**>(GetData(now));
+
+					Recycle(cache, now);
+
+					now = next;
+				}
+			}
+
+			static void TrimCache(Cache* cache)
+			{
+				for (auto& freeList : cache->freeList)
+				{
+					Page* now = freeList;
+					while (nullptr != now)
+					{
+						Page* next = now->next;
+
+						DestroyPage(now);
+
+						now = next;
+					}
+
+					freeList = nullptr;
+				}
+			}
+
+			// Free every block on an orphaned cache's remote list, the caller holds the cache's mutex
+			static void DrainOrphan(Cache* cache)
+			{
+				Page* now = cache->remoteList.exchange(nullptr, std::memory_order_seq_cst);
+				while (nullptr != now)
+				{
+					Page* next = *static_cast<Page**>(GetData(now));
+
+					Unlink(now);
+					DestroyPage(now);
+
+					now = next;
+				}
+			}
+
+			// Run when the owner thread exits, the arena may already be gone and left the cache empty
+			static void Orphan(Cache* cache)
+			{
+				{
+					std::lock_guard<std::mutex> lock(cache->mutex);
+
+					Reclaim(cache);
+					TrimCache(cache);
+
+					cache->threadId.store(std::thread::id(), std::memory_order_relaxed);
+					cache->orphaned.store(true, std::memory_order_seq_cst);
+
+					DrainOrphan(cache);
+				}
+
+				ReleaseCache(cache);
+			}
+
+			static void ReleaseCache(Cache* cache)
+			{
+				if (1 == cache->refCount.fetch_sub(1, std::memory_order_acq_rel))
+				{
+					delete cache;
+				}
+			}
+
+			static ThreadCacheList& GetThreadCacheList()
+			{
+				thread_local ThreadCacheList s_threadCacheList;
+
+				return s_threadCacheList;
+			}
+
+			static Binding* GetBindingList()
+			{
+				thread_local Binding s_bindingList[BINDING_COUNT] = {};
+
+				return s_bindingList;
+			}
+
+			static size_t& GetBindingCursor()
+			{
+				thread_local size_t s_bindingCursor = 0;
+
+				return s_bindingCursor;
+			}
+
+		private :
+			Cache* FindCache()
+			{
+				Binding* bindingList = GetBindingList();
+				for (size_t index = 0; index < BINDING_COUNT; index++)
+				{
+					if (bindingList[index].arenaId == m_id)
+					{
+						return bindingList[index].cache;
+					}
+				}
+
+				const std::thread::id threadId = std::this_thread::get_id();
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				Cache* now = m_cacheList;
+				while (nullptr != now)
+				{
+					if (now->threadId.load(std::memory_order_relaxed) == threadId)
+					{
+						Bind(now);
+
+						return now;
+					}
+
+					now = now->next;
+				}
+
+				return nullptr;
+			}
+
+			Cache* GetCache()
+			{
+				Cache* cache = FindCache();
+				if (nullptr != cache)
+				{
+					return cache;
+				}
+
+				// Slow path, only taken on the thread's first allocation from this arena
+				Cache* newCache = AdoptCache();
+				if (nullptr == newCache)
+				{
+					newCache = new (std::nothrow) Cache();
+					if (nullptr == newCache)
+					{
+						return nullptr;
+					}
+
+					std::lock_guard<std::mutex> lock(m_mutex);
+
+					newCache->next = m_cacheList;
+					m_cacheList = newCache;
+				}
+
+				ThreadCacheList& threadCacheList = GetThreadCacheList();
+				newCache->threadNext = threadCacheList.head;
+				threadCacheList.head = newCache;
+
+				Bind(newCache);
+
+				return newCache;
+			}
+
+			// Hand an exited thread's cache to the calling thread, along with the blocks still live in it
+			Cache* AdoptCache()
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				Cache* now = m_cacheList;
+				while (nullptr != now)
+				{
+					if (now->orphaned.load(std::memory_order_acquire))
+					{
+						std::lock_guard<std::mutex> cacheLock(now->mutex);
+
+						now->refCount.fetch_add(1, std::memory_order_relaxed);
+						now->threadId.store(std::this_thread::get_id(), std::memory_order_relaxed);
+						now->orphaned.store(false, std::memory_order_seq_cst);
+
+						return now;
+					}
+
+					now = now->next;
+				}
+
+				return nullptr;
+			}
+
+			void Bind(Cache* cache)
+			{
+				Binding* bindingList = GetBindingList();
+				size_t& cursor = GetBindingCursor();
+
+				bindingList[cursor].arenaId = m_id;
+				bindingList[cursor].cache = cache;
+
+				cursor = (cursor + 1) % BINDING_COUNT;
+			}
+
+			void Release()
+			{
+				Cache* cache = m_cacheList;
+				while (nullptr != cache)
+				{
+					Cache* nextCache = cache->next;
+
+					{
+						// The owner thread may be exiting right now and orphaning the cache
+						std::lock_guard<std::mutex> lock(cache->mutex);
+
+						// Blocks on the remote list are still linked in the cache's page list
+						Page* now = cache->end.next;
+						while (&cache->end != now)
+						{
+							Page* next = now->next;
+
+							DestroyPage(now);
+
+							now = next;
+						}
+
+						cache->end.next = &cache->end;
+						cache->end.prev = &cache->end;
+						cache->remoteList.store(nullptr, std::memory_order_relaxed);
+
+						TrimCache(cache);
+					}
+
+					ReleaseCache(cache);
+
+					cache = nextCache;
+				}
+
+				m_cacheList = nullptr;
+			}
+
+		private :
+			const uint64_t m_id;
+
+			Cache* m_cacheList;
+			std::mutex m_mutex;
+
+			inline static std::atomic<uint64_t> s_nextId = 0;
+	};
+};
+
+#endif // __WTR_CONCURRENTARENA_H__
\ No newline at end of file
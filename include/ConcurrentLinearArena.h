@@ -0,0 +1,235 @@
+#ifndef __WTR_CONCURRENTLINEARARENA_H__
+#define __WTR_CONCURRENTLINEARARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <atomic>
+#include <mutex>
+
+#include "LinearArena.h"
+
+namespace wtr
+{
+	// Linear arena which many threads can bump-allocate from at once.
+	// An allocation is one fetch_add on the current page's offset, the mutex is only taken when a page runs out.
+	// Reset and the destructor must not run while another thread is allocating.
+	class ConcurrentLinearArena
+	{
+		private :
+			struct alignas(std::max_align_t) Page
+			{
+				std::atomic<size_t> offset;
+				size_t size;
+				Page* next;
+
+				Page()
+					: offset(0)
+					, size(0)
+					, next(nullptr)
+				{}
+
+				~Page() = default;
+			};
+
+			// Every reservation is rounded to this, so blocks up to this alignment need no padding
+			static constexpr size_t BASE_ALIGN_SIZE = alignof(Page);
+
+		public :
+			using GrowthPolicy = LinearArena::GrowthPolicy;
+
+			ConcurrentLinearArena()
+				: m_current(nullptr)
+				, m_head(nullptr)
+				, m_tail(nullptr)
+				, m_mutex()
+				, m_policy()
+				, m_nextPageSize(m_policy.initialSize)
+			{}
+
+			explicit ConcurrentLinearArena(const GrowthPolicy& policy)
+				: ConcurrentLinearArena()
+			{
+				m_policy = policy;
+				m_nextPageSize = policy.initialSize;
+			}
+
+			ConcurrentLinearArena(const ConcurrentLinearArena& other) = delete;
+			ConcurrentLinearArena(ConcurrentLinearArena&& other) = delete;
+
+			~ConcurrentLinearArena()
+			{
+				Release();
+			}
+
+			ConcurrentLinearArena& operator=(const ConcurrentLinearArena& other) = delete;
+			ConcurrentLinearArena& operator=(ConcurrentLinearArena&& other) = delete;
+
+		public :
+			template<typename T>
+			void* Allocate()
+			{
+				return Allocate(sizeof(T), alignof(T));
+			}
+
+			void* Allocate(const size_t objectSize, const size_t alignSize = alignof(std::max_align_t))
+			{
+				// The worst case padding is reserved up front, since the offset is unknown before the fetch_add
+				const size_t paddingSize = alignSize > BASE_ALIGN_SIZE ? alignSize - BASE_ALIGN_SIZE : 0;
+				const size_t reserveSize = AlignUp(objectSize, BASE_ALIGN_SIZE) + paddingSize;
+
+				Page* page = m_current.load(std::memory_order_acquire);
+				while (true)
+				{
+					if (nullptr != page && reserveSize <= page->size)
+					{
+						const size_t offset = page->offset.fetch_add(reserveSize, std::memory_order_relaxed);
+						if (offset <= page->size - reserveSize)
+						{
+							const uintptr_t address = reinterpret_cast<uintptr_t>(GetData(page) + offset);
+
+							return reinterpret_cast<void*>(AlignUp(address, alignSize));
+						}
+					}
+
+					page = Advance(page, reserveSize);
+					if (nullptr == page)
+					{
+						return nullptr;
+					}
+				}
+			}
+
+			// Drop every allocation, the pages stay for reuse
+			void Reset()
+			{
+				Page* now = m_head;
+				while (nullptr != now)
+				{
+					now->offset.store(0, std::memory_order_relaxed);
+					now = now->next;
+				}
+
+				m_current.store(m_head, std::memory_order_release);
+			}
+
+			const GrowthPolicy& GetGrowthPolicy() const
+			{
+				return m_policy;
+			}
+
+		private :
+			static size_t AlignUp(const size_t value, const size_t alignSize)
+			{
+				return (value + alignSize - 1) / alignSize * alignSize;
+			}
+
+			static uint8_t* GetData(Page* page)
+			{
+				return reinterpret_cast<uint8_t*>(page) + sizeof(Page);
+			}
+
+			static Page* CreatePage(const size_t pageSize)
+			{
+				void* memory = ::operator new(sizeof(Page) + pageSize, std::nothrow);
+				if (nullptr == memory)
+				{
+					return nullptr;
+				}
+
+				Page* newPage = new (memory) Page();
+				newPage->size = pageSize;
+
+				return newPage;
+			}
+
+			static void DestroyPage(Page* page)
+			{
+				page->~Page();
+
+				::operator delete(static_cast<void*>(page));
+			}
+
+		private :
+			// Slow path, move the arena past the full page unless another thread already did
+			Page* Advance(Page* fullPage, const size_t reserveSize)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				Page* current = m_current.load(std::memory_order_acquire);
+				if (current != fullPage)
+				{
+					return current;
+				}
+
+				// Pages after the current one are left over from a Reset and are empty
+				Page* next = (nullptr == current) ? m_head : current->next;
+				if (nullptr == next)
+				{
+					next = CreatePage(GetNextPageSize(reserveSize));
+					if (nullptr == next)
+					{
+						return nullptr;
+					}
+
+					if (nullptr == m_tail)
+					{
+						m_head = next;
+					}
+					else
+					{
+						m_tail->next = next;
+					}
+
+					m_tail = next;
+				}
+
+				m_current.store(next, std::memory_order_release);
+
+				return next;
+			}
+
+			size_t GetNextPageSize(const size_t memorySize)
+			{
+				const size_t pageSize = AlignUp(m_nextPageSize, BASE_ALIGN_SIZE);
+
+				if (m_nextPageSize < m_policy.maxPageSize)
+				{
+					const size_t grownSize = m_nextPageSize * m_policy.growthFactor;
+					m_nextPageSize = (grownSize > m_policy.maxPageSize || grownSize < m_nextPageSize) ? m_policy.maxPageSize : grownSize;
+				}
+
+				return memorySize > pageSize ? memorySize : pageSize;
+			}
+
+			void Release()
+			{
+				Page* now = m_head;
+				while (nullptr != now)
+				{
+					Page* next = now->next;
+
+					DestroyPage(now);
+
+					now = next;
+				}
+
+				m_current.store(nullptr, std::memory_order_relaxed);
+				m_head = nullptr;
+				m_tail = nullptr;
+			}
+
+		private :
+			std::atomic<Page*> m_current;
+
+			// The page chain is only changed under the mutex
+			Page* m_head;
+			Page* m_tail;
+			std::mutex m_mutex;
+
+			GrowthPolicy m_policy;
+			size_t m_nextPageSize;
+	};
+};
+
+#endif // __WTR_CONCURRENTLINEARARENA_H__
\ No newline at end of file
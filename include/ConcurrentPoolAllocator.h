@@ -0,0 +1,116 @@
+#ifndef __WTR_CONCURRENTPOOLALLOCATOR_H__
+#define __WTR_CONCURRENTPOOLALLOCATOR_H__
+
+#include <cstddef>
+#include <cassert>
+#include <atomic>
+#include <thread>
+
+#include "PoolAllocator.h"
+
+namespace wtr
+{
+	// Pool of fixed size blocks which is allocated from by one owner thread and freed from any thread.
+	// Like PoolAllocator it only serves requests up to BlockSize, so it backs node containers such as List,
+	// not DynamicArray or HashTable whose buffers grow past any fixed block.
+	// The owner is the first thread to allocate, its own frees go straight back to the pool.
+	// Frees from other threads are pushed on a lock-free stack, and the owner takes the whole stack back on its next Allocate.
+	// Every thread must be done with the pool before it is destroyed.
+	template<size_t BlockSize, size_t SlabSize = 64 * 1024>
+	class ConcurrentPoolAllocator
+	{
+		private :
+			using PoolType = PoolAllocator<BlockSize, SlabSize>;
+
+			struct FreeBlock
+			{
+				FreeBlock* next;
+			};
+
+		public :
+			static constexpr size_t BLOCK_SIZE = PoolType::BLOCK_SIZE;
+			static constexpr size_t BLOCK_ALIGN_SIZE = PoolType::BLOCK_ALIGN_SIZE;
+
+			ConcurrentPoolAllocator()
+				: m_pool()
+				, m_ownerId()
+				, m_remoteHead(nullptr)
+			{}
+
+			ConcurrentPoolAllocator(const ConcurrentPoolAllocator& other) = delete;
+			ConcurrentPoolAllocator(ConcurrentPoolAllocator&& other) = delete;
+
+			~ConcurrentPoolAllocator() = default;
+
+			ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator& other) = delete;
+			ConcurrentPoolAllocator& operator=(ConcurrentPoolAllocator&& other) = delete;
+
+		public :
+			void* Allocate(const size_t memorySize = BlockSize, const size_t alignSize = BLOCK_ALIGN_SIZE)
+			{
+				if (std::thread::id() == m_ownerId)
+				{
+					m_ownerId = std::this_thread::get_id();
+				}
+
+				assert(m_ownerId == std::this_thread::get_id() && "Only the owner thread can allocate from the concurrent pool allocator");
+
+				if (nullptr != m_remoteHead.load(std::memory_order_relaxed))
+				{
+					Reclaim();
+				}
+
+				return m_pool.Allocate(memorySize, alignSize);
+			}
+
+			void Deallocate(void* pointer)
+			{
+				if (nullptr == pointer)
+				{
+					return;
+				}
+
+				if (m_ownerId == std::this_thread::get_id())
+				{
+					m_pool.Deallocate(pointer);
+					return;
+				}
+
+				// The block's memory is dead, so its first word links the stack
+				FreeBlock* block = static_cast<FreeBlock*>(pointer);
+
+				FreeBlock* head = m_remoteHead.load(std::memory_order_relaxed);
+				do
+				{
+					block->next = head;
+				} while (!m_remoteHead.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+		private :
+			// Detach the whole remote stack in one swap, then give its blocks to the pool without further atomics.
+			// Nothing is ever popped one at a time, so a push only compares against the head it linked to
+			// and needs no ABA tag: a head that was detached and pushed again still links the right list.
+			void Reclaim()
+			{
+				FreeBlock* now = m_remoteHead.exchange(nullptr, std::memory_order_acquire);
+				while (nullptr != now)
+				{
+					FreeBlock* next = now->next;
+
+					m_pool.Deallocate(static_cast<void*>(now));
+
+					now = next;
+				}
+			}
+
+		private :
+			// Only touched by the owner thread
+			PoolType m_pool;
+			std::thread::id m_ownerId;
+
+			// Written by every freeing thread, so it sits on its own cache line
+			alignas(64) std::atomic<FreeBlock*> m_remoteHead;
+	};
+};
+
+#endif // __WTR_CONCURRENTPOOLALLOCATOR_H__
\ No newline at end of file
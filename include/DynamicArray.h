@@ -7,13 +7,17 @@
 #include <initializer_list>
 #include <type_traits>
 #include <functional>
-#include <queue>
+#include <cstring>
 
 #include "Arena.h"
+#include "TypeTraits.h"
+#include "GrowthPolicy.h"
+#include "Sort.h"
+#include "Simd.h"
 
 namespace wtr
 {
-	template<typename T, typename Allocator = Arena>
+	template<typename T, typename Allocator = Arena, typename GrowthPolicy = DoubleGrowth<>>
 	class DynamicArray
 	{
 	public :
@@ -154,6 +158,7 @@ namespace wtr
 	public :
 		using ValueType = T;
 		using AllocatorType = Allocator;
+		using GrowthPolicyType = GrowthPolicy;
 
 		public :
 			DynamicArray()
@@ -163,6 +168,13 @@ namespace wtr
 				, m_allocator()
 			{}
 
+			explicit DynamicArray(AllocatorType allocator)
+				: m_data(nullptr)
+				, m_size(0)
+				, m_capacity(0)
+				, m_allocator(std::move(allocator))
+			{}
+
 			DynamicArray(const std::initializer_list<T>& initList)
 				: DynamicArray()
 			{
@@ -176,26 +188,44 @@ namespace wtr
 			}
 
 			DynamicArray(const DynamicArray& other)
+				: m_data(nullptr)
+				, m_size(0)
+				, m_capacity(0)
+				, m_allocator(SelectAllocator(other.m_allocator))
 			{
+				if (other.Empty())
+				{
+					return;
+				}
+
 				m_size = other.m_size;
 				m_capacity = other.m_size;
 
-				m_data = static_cast<T*>(m_allocator.Allocate(sizeof(T) * m_capacity));
+				m_data = static_cast<T*>(m_allocator.Allocate(sizeof(T) * m_capacity, alignof(T)));
 
-				for (size_t index = 0; index < m_size; index++)
-				{
-					new (m_data + index) T(other[index]);
-				}
+				CopyConstruct(m_data, other.m_data, m_size);
 			}
 
-			DynamicArray(DynamicArray&& other) noexcept
-				: m_data(std::move(other.m_data))
-				, m_size(std::move(other.m_size))
-				, m_capacity(std::move(other.m_capacity))
+			DynamicArray(DynamicArray&& other) noexcept(std::is_move_constructible_v<Allocator>)
+				: m_data(nullptr)
+				, m_size(0)
+				, m_capacity(0)
+				, m_allocator(SelectMovedAllocator(other.m_allocator))
 			{
-				other.m_data = nullptr;
-				other.m_size = 0;
-				other.m_capacity = 0;
+				if constexpr (std::is_move_constructible_v<Allocator>)
+				{
+					m_data = other.m_data;
+					m_size = other.m_size;
+					m_capacity = other.m_capacity;
+
+					other.m_data = nullptr;
+					other.m_size = 0;
+					other.m_capacity = 0;
+				}
+				else
+				{
+					MoveElements(other);
+				}
 			}
 
 			~DynamicArray()
@@ -213,16 +243,13 @@ namespace wtr
 					if (m_capacity < other.m_size)
 					{
 						m_allocator.Deallocate(m_data);
-						m_data = static_cast<T*>(m_allocator.Allocate(sizeof(T) * other.m_size));
+						m_data = static_cast<T*>(m_allocator.Allocate(sizeof(T) * other.m_size, alignof(T)));
 					}
 
 					m_size = other.m_size;
 					m_capacity = other.m_size;
 
-					for (size_t index = 0; index < other.m_size; index++)
-					{
-						new (m_data + index) T(other[index]);
-					}
+					CopyConstruct(m_data, other.m_data, m_size);
 				}
 
 				return *this;
@@ -234,14 +261,23 @@ namespace wtr
 				{
 					Clear();
 
-					m_allocator = std::move(other.m_allocator);
-					m_data = std::move(other.m_data);
-					m_size = std::move(other.m_size);
-					m_capacity = std::move(other.m_capacity);
+					if constexpr (std::is_move_assignable_v<Allocator>)
+					{
+						m_allocator.Deallocate(m_data);
 
-					other.m_data = nullptr;
-					other.m_size = 0;
-					other.m_capacity = 0;
+						m_allocator = std::move(other.m_allocator);
+						m_data = std::move(other.m_data);
+						m_size = std::move(other.m_size);
+						m_capacity = std::move(other.m_capacity);
+
+						other.m_data = nullptr;
+						other.m_size = 0;
+						other.m_capacity = 0;
+					}
+					else
+					{
+						MoveElements(other);
+					}
 				}
 
 				return *this;
@@ -309,6 +345,16 @@ namespace wtr
 			return m_data;
 		}
 
+		AllocatorType& GetAllocator()
+		{
+			return m_allocator;
+		}
+
+		const AllocatorType& GetAllocator() const
+		{
+			return m_allocator;
+		}
+
 		T& Front()
 		{
 			assert(0 < m_size && "The array is empty, failed to get the front data");
@@ -347,8 +393,7 @@ namespace wtr
 		{
 			if (0 != m_size && nullptr != m_data)
 			{
-				T* instance = m_data + (m_size - 1);
-				instance->~T();
+				Destroy(m_data + (m_size - 1), 1);
 
 				m_size--;
 			}
@@ -359,14 +404,62 @@ namespace wtr
 		{
 			if (m_size == m_capacity)
 			{
-				const size_t newCapacity = (0 == m_capacity) ? 4 : m_capacity * 2;
-				Reserve(newCapacity);
+				Grow(m_size + 1);
 			}
 
 			new (m_data + m_size) T(std::forward<Args>(args)...);
 			m_size++;
 		}
 
+		// Skips the capacity check, only for use after a Reserve which left room for the element
+		template<typename... Args>
+		void EmplaceBackUnchecked(Args&&... args)
+		{
+			assert(m_size < m_capacity && "The array is full, reserve before emplacing unchecked");
+
+			new (m_data + m_size) T(std::forward<Args>(args)...);
+			m_size++;
+		}
+
+		// Copy count elements to the back with one capacity check, the source may be part of this array
+		void Append(const T* data, const size_t count)
+		{
+			if (0 == count)
+			{
+				return;
+			}
+
+			const T* source = data;
+			if (m_size + count > m_capacity)
+			{
+				const bool isSelf = nullptr != m_data && data >= m_data && data < m_data + m_size;
+				const size_t offset = isSelf ? static_cast<size_t>(data - m_data) : 0;
+
+				Grow(m_size + count);
+
+				source = isSelf ? m_data + offset : data;
+			}
+
+			CopyConstruct(m_data + m_size, source, count);
+			m_size += count;
+		}
+
+		// Named apart from Append, since Append(data, 0) would be ambiguous between a count and a null end pointer
+		void AppendRange(const T* first, const T* last)
+		{
+			Append(first, static_cast<size_t>(last - first));
+		}
+
+		void AppendRange(ConstIterator first, ConstIterator last)
+		{
+			if (first == last)
+			{
+				return;
+			}
+
+			Append(first.m_array->m_data + first.m_index, last.m_index - first.m_index);
+		}
+
 		bool Empty() const
 		{
 			return m_size == 0;
@@ -407,52 +500,99 @@ namespace wtr
 			}
 			else
 			{
-				for (size_t index = newSize; index < m_size; index++)
-				{
-					T* instance = m_data + index;
-					if (nullptr != instance)
-					{
-						instance->~T();
-					}
-				}
+				Destroy(m_data + newSize, m_size - newSize);
 			}
 
 
 			m_size = newSize;
 		}
 
+		// Grow or shrink without constructing the new elements, so they hold whatever the memory held until written
+		void ResizeUninitialized(const size_t newSize)
+		{
+			static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>, "Only trivial types can be resized uninitialized");
+
+			if (newSize > m_capacity)
+			{
+				Reserve(newSize);
+			}
+
+			m_size = newSize;
+		}
+
 		void Reserve(const size_t newCapacity)
 		{
 			if (newCapacity > m_capacity)
 			{
-				T* newData = static_cast<T*>(m_allocator.Allocate(sizeof(T) * newCapacity));
+				const size_t newMemorySize = sizeof(T) * newCapacity;
 
-				for (size_t index = 0; index < m_size; index++)
+				// Extend only succeeds inside the block's slack or on a mapped block, Arena heap blocks still move
+				if constexpr (HasExtend<Allocator>::value)
+				{
+					if (nullptr != m_data && m_allocator.Extend(m_data, newMemorySize))
+					{
+						m_capacity = newCapacity;
+						return;
+					}
+				}
+
+				// A trivially relocatable move is one memcpy inside the allocator instead of a move and destroy per element
+				if constexpr (HasReallocate<Allocator>::value && IsTriviallyRelocatable<T>::value)
 				{
-					new (newData + index) T(std::move(m_data[index]));
+					T* newData = (nullptr == m_data)
+						? static_cast<T*>(m_allocator.Allocate(newMemorySize, alignof(T)))
+						: static_cast<T*>(m_allocator.Reallocate(m_data, sizeof(T) * m_size, newMemorySize));
+					if (nullptr == newData)
+					{
+						return;
+					}
 
-					m_data[index].~T();
+					m_capacity = newCapacity;
+					m_data = newData;
 				}
+				else
+				{
+					T* newData = static_cast<T*>(m_allocator.Allocate(newMemorySize, alignof(T)));
 
-				m_allocator.Deallocate(m_data);
-				m_capacity = newCapacity;
-				m_data = newData;
+					Relocate(newData, m_data, m_size);
+
+					m_allocator.Deallocate(m_data);
+					m_capacity = newCapacity;
+					m_data = newData;
+				}
 			}
 		}
 
 		void Clear()
 		{
-			for (size_t index = 0; index < m_size; index++)
+			Destroy(m_data, m_size);
+
+			m_size = 0;
+		}
+
+		// Move the elements to a block of exactly Size() elements and free the old one
+		void ShrinkToFit()
+		{
+			if (m_capacity == m_size)
 			{
-				T* instance = m_data + index;
+				return;
+			}
 
-				if (nullptr != instance)
+			T* newData = nullptr;
+			if (0 != m_size)
+			{
+				newData = static_cast<T*>(m_allocator.Allocate(sizeof(T) * m_size, alignof(T)));
+				if (nullptr == newData)
 				{
-					instance->~T();
+					return;
 				}
+
+				Relocate(newData, m_data, m_size);
 			}
 
-			m_size = 0;
+			m_allocator.Deallocate(m_data);
+			m_capacity = m_size;
+			m_data = newData;
 		}
 
 		void Assign(const std::initializer_list<T>& initList)
@@ -471,17 +611,29 @@ namespace wtr
 	public :
 		Iterator Insert(ConstIterator pos, T&& value)
 		{
-			const size_t newSize = m_size + 1;
-			Resize(newSize);
-
-			for (size_t index = m_size - 1; index > pos.m_index; index--)
+			if constexpr (IsTriviallyRelocatable<T>::value)
 			{
-				m_data[index] = std::move(m_data[index - 1]);
+				OpenGap(pos.m_index, 1);
+
+				new (m_data + pos.m_index) T(std::move(value));
+
+				return Iterator(*this, pos.m_index);
 			}
+			else
+			{
+				const size_t newSize = m_size + 1;
+				Grow(newSize);
+				Resize(newSize);
+
+				for (size_t index = m_size - 1; index > pos.m_index; index--)
+				{
+					m_data[index] = std::move(m_data[index - 1]);
+				}
 
-			m_data[pos.m_index] = std::move(value);
+				m_data[pos.m_index] = std::move(value);
 
-			return Iterator(*this, pos.m_index);
+				return Iterator(*this, pos.m_index);
+			}
 		}
 
 		Iterator Insert(ConstIterator pos, Iterator first, Iterator last)
@@ -492,10 +644,24 @@ namespace wtr
 			}
 
 			const size_t diffIndex = (last.m_index - first.m_index);
+
+			if constexpr (IsTriviallyRelocatable<T>::value)
+			{
+				if (this != first.m_array)
+				{
+					OpenGap(pos.m_index, diffIndex);
+
+					CopyConstruct(m_data + pos.m_index, first.m_array->m_data + first.m_index, diffIndex);
+
+					return Iterator(*this, pos.m_index);
+				}
+			}
+
 			const size_t newSize = diffIndex + m_size;
+			Grow(newSize);
 			Resize(newSize);
 
-			for (size_t index = m_size - 1; index > pos.m_index + diffIndex; index--)
+			for (size_t index = m_size - 1; index >= pos.m_index + diffIndex; index--)
 			{
 				m_data[index] = std::move(m_data[index - diffIndex]);
 			}
@@ -512,20 +678,33 @@ namespace wtr
 		Iterator Insert(ConstIterator pos, const std::initializer_list<T>& initList)
 		{
 			const size_t offset = initList.size();
-			const size_t newSize = m_size + offset;
-			Resize(newSize);
 
-			for (size_t index = m_size - 1; index > pos.m_index + offset - 1; index--)
+			if constexpr (IsTriviallyRelocatable<T>::value)
 			{
-				m_data[index] = std::move(m_data[index - offset]);
-			}
+				OpenGap(pos.m_index, offset);
 
-			for (size_t index = 0; index < offset; index++)
-			{
-				m_data[index + pos.m_index] = initList[index];
+				CopyConstruct(m_data + pos.m_index, initList.begin(), offset);
+
+				return Iterator(*this, pos.m_index);
 			}
+			else
+			{
+				const size_t newSize = m_size + offset;
+				Grow(newSize);
+				Resize(newSize);
 
-			return Iterator(*this, pos.m_index);
+				for (size_t index = m_size - 1; index > pos.m_index + offset - 1; index--)
+				{
+					m_data[index] = std::move(m_data[index - offset]);
+				}
+
+				for (size_t index = 0; index < offset; index++)
+				{
+					m_data[index + pos.m_index] = *(initList.begin() + index);
+				}
+
+				return Iterator(*this, pos.m_index);
+			}
 		}
 
 		Iterator Erase(Iterator pos)
@@ -557,14 +736,21 @@ namespace wtr
 			}
 
 			const size_t length = last.m_index - first.m_index;
-			for (size_t index = first.m_index; index < m_size - length; index++)
+
+			if constexpr (IsTriviallyRelocatable<T>::value)
 			{
-				m_data[index] = std::move(m_data[index + length]);
-			}
+				Destroy(m_data + first.m_index, length);
 
-			for (size_t index = m_size - length; index < m_size; index++)
+				std::memmove(static_cast<void*>(m_data + first.m_index), static_cast<const void*>(m_data + last.m_index), sizeof(T) * (m_size - last.m_index));
+			}
+			else
 			{
-				m_data[index].~T();
+				for (size_t index = first.m_index; index < m_size - length; index++)
+				{
+					m_data[index] = std::move(m_data[index + length]);
+				}
+
+				Destroy(m_data + (m_size - length), length);
 			}
 
 			m_size -= length;
@@ -574,25 +760,39 @@ namespace wtr
 
 		Iterator Find(const ValueType& other)
 		{
-			auto itr = Begin();
-			while (itr != End())
-			{
-				const auto& value = *itr;
+			return Iterator(*this, SimdAlgorithm::Find(m_data, m_size, other));
+		}
 
-				if (value == other)
-				{
-					return itr;
-				}
-				else
-				{
-					itr++;
-				}
+		template<typename Predicate>
+		Iterator FindIf(const Predicate& predicate)
+		{
+			return Iterator(*this, SimdAlgorithm::FindIf(m_data, m_size, predicate));
+		}
+
+		template<typename Compare>
+		void Sort(ConstIterator first, ConstIterator last, Compare compare)
+		{
+			if (first == last || Empty())
+			{
+				return;
 			}
 
-			return End();
+			const size_t front = first.m_index < last.m_index ? first.m_index : last.m_index;
+			const size_t back = first.m_index < last.m_index ? last.m_index : first.m_index + 1;
+
+			SortAlgorithm::Sort(m_data + front, m_data + back, compare);
 		}
 
-		void Sort(ConstIterator first, ConstIterator last, const std::function<bool(const ValueType&, const ValueType)>& func)
+		template<typename Compare = std::less<T>>
+		void Sort(Compare compare = Compare())
+		{
+			SortAlgorithm::Sort(m_data, m_data + m_size, compare);
+		}
+
+		// Keeps the order of equal elements, the merge buffer for half the range is taken from the allocator.
+		// Without a buffer the runs are merged in place, slower but just as stable.
+		template<typename Compare>
+		void StableSort(ConstIterator first, ConstIterator last, Compare compare)
 		{
 			if (first == last || Empty())
 			{
@@ -600,98 +800,106 @@ namespace wtr
 			}
 
 			const size_t front = first.m_index < last.m_index ? first.m_index : last.m_index;
-			const size_t back = first.m_index < last.m_index ? last.m_index - 1 : first.m_index;
-			if (front == back)
+			const size_t back = first.m_index < last.m_index ? last.m_index : first.m_index + 1;
+
+			StableSortRange(m_data + front, m_data + back, compare);
+		}
+
+		template<typename Compare = std::less<T>>
+		void StableSort(Compare compare = Compare())
+		{
+			StableSortRange(m_data, m_data + m_size, compare);
+		}
+
+		// Stable linear time sort on the integer, enum or floating point key returned by keyFunc, by default the element itself.
+		// The scatter buffer for the whole range is taken from the allocator, without it the range is stable sorted on the key.
+		template<typename KeyFunc = IdentityKey>
+		void RadixSort(KeyFunc keyFunc = KeyFunc())
+		{
+			if (m_size <= SortAlgorithm::RADIX_SORT_THRESHOLD)
 			{
+				SortAlgorithm::RadixSort(m_data, m_data + m_size, keyFunc, static_cast<T*>(nullptr));
 				return;
 			}
 
-			struct Pivot
+			T* buffer = static_cast<T*>(m_allocator.Allocate(sizeof(T) * SortAlgorithm::GetRadixBufferSize(m_size), alignof(T)));
+			if (nullptr == buffer)
 			{
-				size_t pivot;
-				size_t lower;
-				size_t upper;
-			};
+				auto compare = SortAlgorithm::GetRadixCompare<T>(keyFunc);
+				StableSortRange(m_data, m_data + m_size, compare);
+				return;
+			}
 
-			Pivot start;
-			start.lower = front;
-			start.upper = back;
-			start.pivot = (start.lower + start.upper) / 2;
+			SortAlgorithm::RadixSort(m_data, m_data + m_size, keyFunc, buffer);
 
-			std::queue<Pivot> pivotQueue;
-			pivotQueue.push(start);
+			m_allocator.Deallocate(buffer);
+		}
 
-			while (!pivotQueue.empty())
+		// Sorts one chunk per thread and merges them in parallel, threadCount 0 uses every hardware thread.
+		// Not stable, equal elements may come out in any order like with Sort.
+		// Falls back to Sort for small ranges, or when the allocator can not give a buffer for the whole range.
+		template<typename Compare>
+		void ParallelSort(ConstIterator first, ConstIterator last, Compare compare, const size_t threadCount = 0)
+		{
+			if (first == last || Empty())
 			{
-				Pivot pivot = pivotQueue.front();
-				pivotQueue.pop();
+				return;
+			}
 
-				const size_t lower = pivot.lower;
-				const size_t upper = pivot.upper;
+			const size_t front = first.m_index < last.m_index ? first.m_index : last.m_index;
+			const size_t back = first.m_index < last.m_index ? last.m_index : first.m_index + 1;
 
-				while (pivot.lower <= pivot.upper)
-				{
-					bool lowerBigger = !func(m_data[pivot.lower], m_data[pivot.pivot]);
-					bool upperSmaller = !func(m_data[pivot.pivot], m_data[pivot.upper]);
+			ParallelSortRange(m_data + front, m_data + back, compare, threadCount);
+		}
 
-					if (lowerBigger && upperSmaller)
-					{
-						ValueType value = m_data[pivot.lower];
-						m_data[pivot.lower] = m_data[pivot.upper];
-						m_data[pivot.upper] = value;
-					}
+		template<typename Compare = std::less<T>>
+		void ParallelSort(Compare compare = Compare(), const size_t threadCount = 0)
+		{
+			ParallelSortRange(m_data, m_data + m_size, compare, threadCount);
+		}
 
-					if (pivot.lower == pivot.upper)
-					{
-						pivot.lower = (pivot.lower < upper) ? pivot.lower + 1 : pivot.lower;
-					}
-					else
-					{
-						pivot.lower = (!lowerBigger || upperSmaller) && (pivot.lower < upper) ? pivot.lower + 1 : pivot.lower;
-						pivot.upper = (!upperSmaller || lowerBigger) && (pivot.upper > lower) ? pivot.upper - 1 : pivot.upper;
-					}
-				}
+		ConstIterator Find(const ValueType& other) const
+		{
+			return ConstIterator(*this, SimdAlgorithm::Find(m_data, m_size, other));
+		}
 
-				if (lower < pivot.upper)
-				{
-					Pivot left;
-					left.lower = lower;
-					left.upper = pivot.upper;
-					left.pivot = (left.lower + left.upper) / 2;
+		// Predicates like LessThan or InRange are vectorized for arithmetic elements, any other callable is tested one by one
+		template<typename Predicate>
+		ConstIterator FindIf(const Predicate& predicate) const
+		{
+			return ConstIterator(*this, SimdAlgorithm::FindIf(m_data, m_size, predicate));
+		}
 
-					pivotQueue.push(left);
-				}
+		bool Contains(const ValueType& other) const
+		{
+			return m_size != SimdAlgorithm::Find(m_data, m_size, other);
+		}
 
-				if (upper > pivot.lower)
-				{
-					Pivot right;
-					right.lower = pivot.lower;
-					right.upper = upper;
-					right.pivot = (right.lower + right.upper) / 2;
+		size_t Count(const ValueType& other) const
+		{
+			return SimdAlgorithm::Count(m_data, m_size, other);
+		}
 
-					pivotQueue.push(right);
-				}
-			}
+		template<typename Predicate>
+		size_t CountIf(const Predicate& predicate) const
+		{
+			return SimdAlgorithm::CountIf(m_data, m_size, predicate);
 		}
 
-		ConstIterator Find(const ValueType& other) const
+		// Arrays holding NaN have no defined minimum or maximum; the result may or may not be a NaN
+		// depending on where it sits and whether the SIMD kernel ran, so filter NaN out first
+		ValueType Min() const
 		{
-			auto itr = Begin();
-			while (itr != End())
-			{
-				const auto& value = *itr;
+			assert(0 < m_size && "The array is empty, failed to get the minimum");
 
-				if (value == other)
-				{
-					return itr;
-				}
-				else
-				{
-					itr++;
-				}
-			}
+			return SimdAlgorithm::Min(m_data, m_size);
+		}
 
-			return End();
+		ValueType Max() const
+		{
+			assert(0 < m_size && "The array is empty, failed to get the maximum");
+
+			return SimdAlgorithm::Max(m_data, m_size);
 		}
 
 		size_t Distance(ConstIterator first, ConstIterator last) const
@@ -722,6 +930,139 @@ namespace wtr
 		ConstReverseIterator rBegin() const { return ConstReverseIterator(*this, m_size); }
 		ConstReverseIterator rEnd() const { return ConstReverseIterator(*this, 0); }
 
+	private :
+		// The allocator can not be moved, so its memory stays with the other array and the elements are moved one by one
+		void MoveElements(DynamicArray& other)
+		{
+			Reserve(other.m_size);
+
+			Relocate(m_data, other.m_data, other.m_size);
+
+			m_size = other.m_size;
+			other.m_size = 0;
+		}
+
+		// Move count elements to uninitialized memory, the source is left without live elements
+		static void Relocate(T* destination, T* source, const size_t count)
+		{
+			if (0 == count)
+			{
+				return;
+			}
+
+			if constexpr (IsTriviallyRelocatable<T>::value)
+			{
+				std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(T) * count);
+			}
+			else
+			{
+				for (size_t index = 0; index < count; index++)
+				{
+					new (destination + index) T(std::move(source[index]));
+
+					source[index].~T();
+				}
+			}
+		}
+
+		static void CopyConstruct(T* destination, const T* source, const size_t count)
+		{
+			if (0 == count)
+			{
+				return;
+			}
+
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(T) * count);
+			}
+			else
+			{
+				for (size_t index = 0; index < count; index++)
+				{
+					new (destination + index) T(source[index]);
+				}
+			}
+		}
+
+		static void Destroy(T* data, const size_t count)
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (size_t index = 0; index < count; index++)
+				{
+					data[index].~T();
+				}
+			}
+		}
+
+		void Grow(const size_t minCapacity)
+		{
+			if (minCapacity > m_capacity)
+			{
+				Reserve(GrowthPolicy::GetCapacity(m_capacity, minCapacity));
+			}
+		}
+
+		// Grow to fit count more elements and relocate the tail, leaving [index, index + count) uninitialized
+		void OpenGap(const size_t index, const size_t count)
+		{
+			if (0 == count)
+			{
+				return;
+			}
+
+			const size_t newSize = m_size + count;
+			Grow(newSize);
+
+			std::memmove(static_cast<void*>(m_data + index + count), static_cast<const void*>(m_data + index), sizeof(T) * (m_size - index));
+
+			m_size = newSize;
+		}
+
+		template<typename Compare>
+		void StableSortRange(T* first, T* last, Compare& compare)
+		{
+			const size_t size = static_cast<size_t>(last - first);
+			if (size <= SortAlgorithm::STABLE_RUN_SIZE)
+			{
+				SortAlgorithm::InsertionSort(first, last, compare);
+				return;
+			}
+
+			// A nullptr buffer makes StableSort merge in place
+			T* buffer = static_cast<T*>(m_allocator.Allocate(sizeof(T) * SortAlgorithm::GetStableBufferSize(size), alignof(T)));
+
+			SortAlgorithm::StableSort(first, last, compare, buffer);
+
+			if (nullptr != buffer)
+			{
+				m_allocator.Deallocate(buffer);
+			}
+		}
+
+		template<typename Compare>
+		void ParallelSortRange(T* first, T* last, Compare& compare, const size_t threadCount)
+		{
+			const size_t size = static_cast<size_t>(last - first);
+			if (1 == SortAlgorithm::GetParallelThreadCount(size, threadCount))
+			{
+				SortAlgorithm::Sort(first, last, compare);
+				return;
+			}
+
+			T* buffer = static_cast<T*>(m_allocator.Allocate(sizeof(T) * SortAlgorithm::GetParallelBufferSize(size), alignof(T)));
+			if (nullptr == buffer)
+			{
+				SortAlgorithm::Sort(first, last, compare);
+				return;
+			}
+
+			SortAlgorithm::ParallelSort(first, last, compare, buffer, threadCount);
+
+			m_allocator.Deallocate(buffer);
+		}
+
 	private :
 		T* m_data;
 		size_t m_size;
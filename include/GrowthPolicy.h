@@ -0,0 +1,47 @@
+#ifndef __WTR_GROWTHPOLICY_H__
+#define __WTR_GROWTHPOLICY_H__
+
+#include <cstddef>
+
+namespace wtr
+{
+	// Growth policies of DynamicArray, GetCapacity returns the capacity to grow to, at least minCapacity.
+	// Doubling makes the fewest reallocations, 1.5x wastes at most a third of the block,
+	// and a fixed chunk keeps the waste below one chunk for very large arrays.
+	template<size_t InitialCapacity = 4>
+	struct DoubleGrowth
+	{
+		static size_t GetCapacity(const size_t capacity, const size_t minCapacity)
+		{
+			const size_t newCapacity = (0 == capacity) ? InitialCapacity : capacity * 2;
+
+			return newCapacity > minCapacity ? newCapacity : minCapacity;
+		}
+	};
+
+	template<size_t InitialCapacity = 4>
+	struct OneHalfGrowth
+	{
+		static size_t GetCapacity(const size_t capacity, const size_t minCapacity)
+		{
+			const size_t newCapacity = (0 == capacity) ? InitialCapacity : capacity + (capacity + 1) / 2;
+
+			return newCapacity > minCapacity ? newCapacity : minCapacity;
+		}
+	};
+
+	template<size_t ChunkCapacity>
+	struct ChunkGrowth
+	{
+		static_assert(0 != ChunkCapacity, "The growth policy's chunk must not be empty");
+
+		static size_t GetCapacity(const size_t capacity, const size_t minCapacity)
+		{
+			const size_t newCapacity = (minCapacity > capacity + ChunkCapacity) ? minCapacity : capacity + ChunkCapacity;
+
+			return (newCapacity + ChunkCapacity - 1) / ChunkCapacity * ChunkCapacity;
+		}
+	};
+};
+
+#endif // __WTR_GROWTHPOLICY_H__
\ No newline at end of file
@@ -279,6 +279,11 @@ namespace wtr
 			, m_count(0)
 		{}
 
+		explicit HashTable(AllocatorType allocator)
+			: m_slotList(std::move(allocator))
+			, m_count(0)
+		{}
+
 		HashTable(const HashTable& other)
 			: m_slotList(other.m_slotList)
 			, m_count(other.m_count)
@@ -359,7 +364,7 @@ namespace wtr
 
 		void Rehash(const size_t newSize)
 		{
-			DynamicArray<Slot, Allocator> newSlotList;
+			DynamicArray<Slot, Allocator> newSlotList = CreateSlotList();
 			newSlotList.Resize(newSize);
 
 			for (auto& slot : m_slotList)
@@ -595,6 +600,19 @@ namespace wtr
 		ConstReverseIterator rEnd() const { return ConstReverseIterator(*this, 0); }
 
 	private :
+		// The new slot list shares a copyable allocator, an allocator which can not be copied gets a fresh instance
+		DynamicArray<Slot, Allocator> CreateSlotList() const
+		{
+			if constexpr (std::is_copy_constructible_v<Allocator>)
+			{
+				return DynamicArray<Slot, Allocator>(m_slotList.GetAllocator());
+			}
+			else
+			{
+				return DynamicArray<Slot, Allocator>();
+			}
+		}
+
 		size_t FindIndex(const Key& key) const
 		{
 			const size_t endIndex = MaxSize();
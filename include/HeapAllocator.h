@@ -0,0 +1,78 @@
+#ifndef __WTR_HEAPALLOCATOR_H__
+#define __WTR_HEAPALLOCATOR_H__
+
+#include <cstddef>
+#include <cassert>
+#include <new>
+
+namespace wtr
+{
+	// Stateless allocator over the global operator new, with no bookkeeping beyond the heap's own.
+	// Every block is aligned to ALIGN_SIZE, which is known at compile time so Deallocate picks the matching delete,
+	// and alignments above __STDCPP_DEFAULT_NEW_ALIGNMENT__ go through the aligned new and delete pair.
+	// Every instance draws from the same heap, so they all compare equal.
+	template<size_t Alignment = alignof(std::max_align_t)>
+	class HeapAllocator
+	{
+	public :
+		static constexpr size_t ALIGN_SIZE = Alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? Alignment : __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+		static_assert(0 == (Alignment & (Alignment - 1)), "The heap allocator's alignment must be a power of two");
+
+		HeapAllocator() = default;
+		HeapAllocator(const HeapAllocator& other) = default;
+		HeapAllocator(HeapAllocator&& other) noexcept = default;
+
+		~HeapAllocator() = default;
+
+		HeapAllocator& operator=(const HeapAllocator& other) = default;
+		HeapAllocator& operator=(HeapAllocator&& other) noexcept = default;
+
+		bool operator==(const HeapAllocator& other) const
+		{
+			(void)other;
+
+			return true;
+		}
+
+		bool operator!=(const HeapAllocator& other) const
+		{
+			return !(*this == other);
+		}
+
+	public :
+		void* Allocate(const size_t memorySize, const size_t alignSize = alignof(std::max_align_t))
+		{
+			assert(0 != alignSize && 0 == (alignSize & (alignSize - 1)) && "The align size must be a power of two");
+			assert(alignSize <= ALIGN_SIZE && "The heap allocator's alignment is too small for the request");
+
+			if (alignSize > ALIGN_SIZE)
+			{
+				return nullptr;
+			}
+
+			if constexpr (ALIGN_SIZE > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				return ::operator new(memorySize, std::align_val_t(ALIGN_SIZE), std::nothrow);
+			}
+			else
+			{
+				return ::operator new(memorySize, std::nothrow);
+			}
+		}
+
+		void Deallocate(void* pointer)
+		{
+			if constexpr (ALIGN_SIZE > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				::operator delete(pointer, std::align_val_t(ALIGN_SIZE));
+			}
+			else
+			{
+				::operator delete(pointer);
+			}
+		}
+	};
+};
+
+#endif // __WTR_HEAPALLOCATOR_H__
\ No newline at end of file
@@ -0,0 +1,216 @@
+#ifndef __WTR_INLINEARENA_H__
+#define __WTR_INLINEARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "Arena.h"
+#include "TypeTraits.h"
+
+namespace wtr
+{
+	// Bump allocate from a buffer owned by the caller, and take the blocks which do not fit from the fallback allocator.
+	// Only the most recent buffer block can be freed or extended, freeing any other buffer block is a no-op.
+	// The buffer must outlive the arena. Moving hands the buffer and the fallback over and leaves the source empty,
+	// so DynamicArray<T, BufferArena<>>(BufferArena<>(buffer, size)) keeps drawing from the same buffer.
+	template<typename Fallback = Arena>
+	class BufferArena
+	{
+	public :
+		using AllocatorType = Fallback;
+
+		BufferArena()
+			: BufferArena(nullptr, 0)
+		{}
+
+		BufferArena(void* buffer, const size_t bufferSize)
+			: m_buffer(static_cast<uint8_t*>(buffer))
+			, m_bufferSize(nullptr != buffer ? bufferSize : 0)
+			, m_offset(0)
+			, m_lastBlock(nullptr)
+			, m_lastOffset(0)
+			, m_fallback()
+		{}
+
+		BufferArena(const BufferArena& other) = delete;
+		BufferArena(BufferArena&& other) noexcept
+			: m_buffer(other.m_buffer)
+			, m_bufferSize(other.m_bufferSize)
+			, m_offset(other.m_offset)
+			, m_lastBlock(other.m_lastBlock)
+			, m_lastOffset(other.m_lastOffset)
+			, m_fallback(std::move(other.m_fallback))
+		{
+			other.Detach();
+		}
+
+		~BufferArena() = default;
+
+		BufferArena& operator=(const BufferArena& other) = delete;
+		BufferArena& operator=(BufferArena&& other) noexcept
+		{
+			if (this != &other)
+			{
+				m_buffer = other.m_buffer;
+				m_bufferSize = other.m_bufferSize;
+				m_offset = other.m_offset;
+				m_lastBlock = other.m_lastBlock;
+				m_lastOffset = other.m_lastOffset;
+				m_fallback = std::move(other.m_fallback);
+
+				other.Detach();
+			}
+
+			return *this;
+		}
+
+	public :
+		void* Allocate(const size_t memorySize, const size_t alignSize = alignof(std::max_align_t))
+		{
+			const uintptr_t address = reinterpret_cast<uintptr_t>(m_buffer + m_offset);
+			const size_t paddingSize = (alignSize - (address % alignSize)) % alignSize;
+
+			if (m_offset + paddingSize <= m_bufferSize && memorySize <= m_bufferSize - m_offset - paddingSize)
+			{
+				m_lastBlock = m_buffer + m_offset + paddingSize;
+				m_lastOffset = m_offset;
+				m_offset += paddingSize + memorySize;
+
+				return static_cast<void*>(m_lastBlock);
+			}
+
+			return m_fallback.Allocate(memorySize, alignSize);
+		}
+
+		void Deallocate(void* pointer)
+		{
+			if (nullptr == pointer)
+			{
+				return;
+			}
+
+			if (Owns(pointer))
+			{
+				if (pointer == m_lastBlock)
+				{
+					m_offset = m_lastOffset;
+					m_lastBlock = nullptr;
+				}
+
+				return;
+			}
+
+			if constexpr (HasDeallocate<Fallback>::value)
+			{
+				m_fallback.Deallocate(pointer);
+			}
+		}
+
+		// Resize the most recent buffer block in place, a fallback block is extended by the fallback when it can
+		bool Extend(void* pointer, const size_t newSize)
+		{
+			if (nullptr == pointer)
+			{
+				return false;
+			}
+
+			if (Owns(pointer))
+			{
+				if (pointer != m_lastBlock)
+				{
+					return false;
+				}
+
+				const size_t blockOffset = static_cast<size_t>(m_lastBlock - m_buffer);
+				if (newSize > m_bufferSize - blockOffset)
+				{
+					return false;
+				}
+
+				m_offset = blockOffset + newSize;
+
+				return true;
+			}
+
+			if constexpr (HasExtend<Fallback>::value)
+			{
+				return m_fallback.Extend(pointer, newSize);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// Drop every buffer block, blocks taken from the fallback are untouched
+		void Reset()
+		{
+			m_offset = 0;
+			m_lastBlock = nullptr;
+		}
+
+		bool Owns(const void* pointer) const
+		{
+			const uint8_t* memory = static_cast<const uint8_t*>(pointer);
+
+			return memory >= m_buffer && memory < m_buffer + m_bufferSize;
+		}
+
+		size_t GetBufferSize() const
+		{
+			return m_bufferSize;
+		}
+
+		size_t GetUsedSize() const
+		{
+			return m_offset;
+		}
+
+	private :
+		void Detach()
+		{
+			m_buffer = nullptr;
+			m_bufferSize = 0;
+			m_offset = 0;
+			m_lastBlock = nullptr;
+			m_lastOffset = 0;
+		}
+
+	private :
+		uint8_t* m_buffer;
+		size_t m_bufferSize;
+		size_t m_offset;
+
+		// Start of the most recent buffer block and the offset before it, so it can be freed or resized
+		uint8_t* m_lastBlock;
+		size_t m_lastOffset;
+
+		Fallback m_fallback;
+	};
+
+	// Buffer arena over an inline buffer of Bytes, so a container with DynamicArray<T, InlineArena<256>>
+	// needs no heap allocation until it outgrows the buffer.
+	// The blocks point into the arena itself, so unlike BufferArena it can not be copied or moved.
+	template<size_t Bytes, typename Fallback = Arena>
+	class InlineArena : public BufferArena<Fallback>
+	{
+	public :
+		InlineArena()
+			: BufferArena<Fallback>(m_storage, Bytes)
+		{}
+
+		InlineArena(const InlineArena& other) = delete;
+		InlineArena(InlineArena&& other) = delete;
+
+		~InlineArena() = default;
+
+		InlineArena& operator=(const InlineArena& other) = delete;
+		InlineArena& operator=(InlineArena&& other) = delete;
+
+	private :
+		alignas(std::max_align_t) uint8_t m_storage[Bytes];
+	};
+};
+
+#endif // __WTR_INLINEARENA_H__
\ No newline at end of file
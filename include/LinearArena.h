@@ -2,10 +2,10 @@
 #define __WTR_LINEARARENA_H__
 
 #include <cstddef>
+#include <cstdint>
 #include <new>
-
-#define MAX(x, y) (x >= y) ? x : y;
-#define MIN(x, y) (x <= y) ? x : y;
+#include <utility>
+#include <type_traits>
 
 namespace wtr
 {
@@ -30,44 +30,91 @@ namespace wtr
 			{
 			}
 
-			~Page()
-			{
-				if (nullptr != data)
-				{
-					delete data;
-				}
-			}
+			~Page() = default;
 
 			bool isFull() const
 			{
 				return offset == size;
 			}
+		};
+
+		// Destructor record of an object made by New, kept in the arena itself
+		struct Finalizer
+		{
+			void (*destroy)(void*);
+			void* object;
+			Finalizer* next;
+		};
+
+	public:
+		// Every new page is growthFactor times the previous one, from initialSize up to maxPageSize.
+		// A request larger than the next page size still gets a page of its own size.
+		struct GrowthPolicy
+		{
+			size_t initialSize = 64 * 1024;
+			size_t growthFactor = 2;
+			size_t maxPageSize = 16 * 1024 * 1024;
+		};
+
+		// Position of the arena, allocations made after Mark are dropped by Rewind
+		struct Marker
+		{
+			Page* page;
+			size_t offset;
+			size_t usedSize;
+			Finalizer* finalizer;
+		};
+
+		// Rewind the arena to where it was when the scope was opened
+		class Scope
+		{
+		public :
+			explicit Scope(LinearArena& arena)
+				: m_arena(arena)
+				, m_marker(arena.Mark())
+			{}
+
+			Scope(const Scope& other) = delete;
+			Scope& operator=(const Scope& other) = delete;
+
+			~Scope()
+			{
+				m_arena.Rewind(m_marker);
+			}
 
-			static constexpr size_t MIN_SIZE = 64 * 1024;
+		private :
+			LinearArena& m_arena;
+			Marker m_marker;
 		};
 
 	public:
 		LinearArena()
 			: m_end()
+			, m_current(&m_end)
+			, m_usedSize(0)
+			, m_peakSize(0)
+			, m_lastBlock(nullptr)
+			, m_lastOffset(0)
+			, m_finalizerList(nullptr)
+			, m_policy()
+			, m_nextPageSize(m_policy.initialSize)
 		{
 			m_end.prev = &m_end;
 			m_end.next = &m_end;
 		}
 
+		explicit LinearArena(const GrowthPolicy& policy)
+			: LinearArena()
+		{
+			m_policy = policy;
+			m_nextPageSize = policy.initialSize;
+		}
+
 		LinearArena(const LinearArena& other) = delete;
 		LinearArena(LinearArena&& other) noexcept
 			: LinearArena()
 		{
-			if (other.m_end.next != &other.m_end)
-			{
-				m_end.next = other.m_end.next;
-				m_end.prev = other.m_end.prev;
-				m_end.next->prev = &m_end;
-				m_end.prev->next = &m_end;
-
-				other.m_end.next = &other.m_end;
-				other.m_end.prev = &other.m_end;
-			}
+			Steal(other);
 		}
 
 		~LinearArena()
@@ -78,17 +125,10 @@ namespace wtr
 		LinearArena& operator=(const LinearArena& other) = delete;
 		LinearArena& operator=(LinearArena&& other) noexcept
 		{
-			if (this != &other && other.m_end.next != &other.m_end)
+			if (this != &other)
 			{
 				Release();
-
-				m_end.next = other.m_end.next;
-				m_end.prev = other.m_end.prev;
-				m_end.next->prev = &m_end;
-				m_end.prev->next = &m_end;
-
-				other.m_end.next = &other.m_end;
-				other.m_end.prev = &other.m_end;
+				Steal(other);
 			}
 
 			return *this;
@@ -104,54 +144,184 @@ namespace wtr
 			return Allocate(objectSize, alignSize);
 		}
 
-		void* Allocate(const size_t objectSize, const size_t alignSize)
+		void* Allocate(const size_t objectSize, const size_t alignSize = alignof(std::max_align_t))
 		{
-			Page* page = m_end.prev;
+			Page* page = m_current;
 
-			size_t paddingSize = (alignSize - (page->offset % alignSize)) % alignSize;
-			size_t totalSize = objectSize + paddingSize;
+			if (!CanFit(page, objectSize, alignSize))
+			{
+				// Pages after the current one are left over from a Reset or a Rewind and are empty
+				page = m_current->next;
 
-			if (page == &m_end || page->isFull() || page->offset + totalSize >= page->size)
+				if (page == &m_end || !CanFit(page, objectSize, alignSize))
+				{
+					page = CreatePage(GetNextPageSize(objectSize + alignSize));
+					if (nullptr == page)
+					{
+						return nullptr;
+					}
+
+					page->prev = m_current;
+					page->next = m_current->next;
+					m_current->next->prev = page;
+					m_current->next = page;
+				}
+
+				m_current = page;
+			}
+
+			const size_t paddingSize = GetPaddingSize(page, alignSize);
+
+			void* memoryStart = static_cast<void*>(page->data + page->offset + paddingSize);
+
+			m_lastBlock = static_cast<uint8_t*>(memoryStart);
+			m_lastOffset = page->offset;
+
+			page->offset += objectSize + paddingSize;
+
+			m_usedSize += objectSize + paddingSize;
+			m_peakSize = m_usedSize > m_peakSize ? m_usedSize : m_peakSize;
+
+			return memoryStart;
+		}
+
+		// Construct a T in the arena, its destructor runs on Reset, on a Rewind past it, or with the arena.
+		// Only non-trivially destructible types cost a destructor record.
+		template<typename T, typename... Args>
+		T* New(Args&&... args)
+		{
+			if constexpr (std::is_trivially_destructible_v<T>)
 			{
-				const size_t pageSize = MAX(objectSize, Page::MIN_SIZE);
-				const size_t pageAlignSize = alignof(Page);
-				const size_t pagePaddingSize = (pageAlignSize - (pageSize % pageAlignSize)) % pageAlignSize;
-				const size_t pageOffsetSize = pageSize + pagePaddingSize;
-				const size_t totalPageSize = pageOffsetSize + sizeof(Page);
+				void* memory = Allocate(sizeof(T), alignof(T));
+				if (nullptr == memory)
+				{
+					return nullptr;
+				}
 
-				void* memory = ::operator new(totalPageSize, std::nothrow);
+				return new (memory) T(std::forward<Args>(args)...);
+			}
+			else
+			{
+				Finalizer* finalizer = static_cast<Finalizer*>(Allocate(sizeof(Finalizer), alignof(Finalizer)));
+				void* memory = (nullptr != finalizer) ? Allocate(sizeof(T), alignof(T)) : nullptr;
 				if (nullptr == memory)
 				{
 					return nullptr;
 				}
 
-				void* pageStart = static_cast<void*>(static_cast<uint8_t*>(memory) + pageOffsetSize);
+				T* object = new (memory) T(std::forward<Args>(args)...);
+
+				finalizer->destroy = &Destroy<T>;
+				finalizer->object = object;
+				finalizer->next = m_finalizerList;
+				m_finalizerList = finalizer;
+
+				// The record points at the object, so the object can not be rolled back on its own
+				m_lastBlock = nullptr;
+
+				return object;
+			}
+		}
+
+		// Only the most recent block is given back, freeing any other block is a no-op
+		void Deallocate(void* pointer)
+		{
+			if (nullptr == pointer || pointer != m_lastBlock)
+			{
+				return;
+			}
+
+			m_usedSize -= m_current->offset - m_lastOffset;
+			m_current->offset = m_lastOffset;
 
-				Page* newPage = new (pageStart) Page();
-				newPage->data = static_cast<uint8_t*>(memory);
-				newPage->offset = 0;
-				newPage->size = pageSize + pagePaddingSize;
+			m_lastBlock = nullptr;
+		}
 
-				m_end.prev->next = newPage;
-				newPage->prev = m_end.prev;
-				newPage->next = &m_end;
-				m_end.prev = newPage;
+		// Resize the most recent block in place, fails for any other block or when the page has no room left
+		bool Extend(void* pointer, const size_t newSize)
+		{
+			if (nullptr == pointer || pointer != m_lastBlock)
+			{
+				return false;
+			}
 
-				page = newPage;
+			const size_t blockOffset = static_cast<size_t>(m_lastBlock - m_current->data);
+			if (newSize > m_current->size - blockOffset)
+			{
+				return false;
 			}
 
-			paddingSize = (alignSize - (page->offset % alignSize)) % alignSize;
-			totalSize = objectSize + paddingSize;
+			const size_t newOffset = blockOffset + newSize;
 
-			void* memoryStart = static_cast<void*>(static_cast<uint8_t*>(page->data) + page->offset + paddingSize);
+			m_usedSize = m_usedSize - m_current->offset + newOffset;
+			m_peakSize = m_usedSize > m_peakSize ? m_usedSize : m_peakSize;
 
-			page->offset += totalSize;
+			m_current->offset = newOffset;
 
-			return memoryStart;
+			return true;
+		}
+
+		Marker Mark() const
+		{
+			Marker marker;
+			marker.page = m_current;
+			marker.offset = m_current->offset;
+			marker.usedSize = m_usedSize;
+			marker.finalizer = m_finalizerList;
+
+			return marker;
+		}
+
+		// Drop every allocation made after the marker, the pages stay for reuse
+		void Rewind(const Marker& marker)
+		{
+			Finalize(marker.finalizer);
+
+			Page* now = m_current;
+			while (now != marker.page && now != &m_end)
+			{
+				now->offset = 0;
+				now = now->prev;
+			}
+
+			marker.page->offset = marker.offset;
+			m_current = marker.page;
+			m_usedSize = marker.usedSize;
+			m_lastBlock = nullptr;
 		}
 
-		void Reset()
+		// With coalesce, the page chain is replaced by one page sized to the peak usage since the last Reset,
+		// so a steady workload fits the next cycle in one linear block
+		void Reset(const bool coalesce = false)
 		{
+			Finalize(nullptr);
+
+			const size_t peakSize = m_peakSize;
+
+			m_usedSize = 0;
+			m_peakSize = 0;
+			m_lastBlock = nullptr;
+
+			if (coalesce && 0 != peakSize && (m_end.next != m_end.prev || m_end.next->size < peakSize))
+			{
+				const size_t nextPageSize = m_nextPageSize;
+
+				Release();
+
+				m_nextPageSize = nextPageSize;
+
+				Page* newPage = CreatePage(peakSize > m_policy.initialSize ? peakSize : m_policy.initialSize);
+				if (nullptr != newPage)
+				{
+					newPage->prev = &m_end;
+					newPage->next = &m_end;
+					m_end.next = newPage;
+					m_end.prev = newPage;
+				}
+
+				return;
+			}
+
 			Page* now = m_end.next;
 			while (nullptr != now && &m_end != now)
 			{
@@ -159,27 +329,171 @@ namespace wtr
 				now->offset = 0;
 				now = next;
 			}
+
+			m_current = &m_end;
+		}
+
+		const GrowthPolicy& GetGrowthPolicy() const
+		{
+			return m_policy;
+		}
+
+	private :
+		template<typename T>
+		static void Destroy(void* object)
+		{
+			static_cast<T*>(object)->~T();
+		}
+
+		static size_t GetPaddingSize(const Page* page, const size_t alignSize)
+		{
+			const uintptr_t address = reinterpret_cast<uintptr_t>(page->data + page->offset);
+
+			return (alignSize - (address % alignSize)) % alignSize;
+		}
+
+		static bool CanFit(const Page* page, const size_t objectSize, const size_t alignSize)
+		{
+			if (nullptr == page->data || page->isFull())
+			{
+				return false;
+			}
+
+			return page->offset + GetPaddingSize(page, alignSize) + objectSize <= page->size;
+		}
+
+		static Page* CreatePage(const size_t pageSize)
+		{
+			const size_t pageAlignSize = alignof(Page);
+			const size_t pagePaddingSize = (pageAlignSize - (pageSize % pageAlignSize)) % pageAlignSize;
+			const size_t pageOffsetSize = pageSize + pagePaddingSize;
+			const size_t totalPageSize = pageOffsetSize + sizeof(Page);
+
+			void* memory = ::operator new(totalPageSize, std::nothrow);
+			if (nullptr == memory)
+			{
+				return nullptr;
+			}
+
+			void* pageStart = static_cast<void*>(static_cast<uint8_t*>(memory) + pageOffsetSize);
+
+			Page* newPage = new (pageStart) Page();
+			newPage->data = static_cast<uint8_t*>(memory);
+			newPage->offset = 0;
+			newPage->size = pageOffsetSize;
+
+			return newPage;
+		}
+
+		static void DestroyPage(Page* page)
+		{
+			void* memory = static_cast<void*>(page->data);
+
+			page->~Page();
+
+			::operator delete(memory);
 		}
 
 	private :
+		// Run the destructors of every object made after the given record, newest first
+		void Finalize(Finalizer* last)
+		{
+			while (m_finalizerList != last && nullptr != m_finalizerList)
+			{
+				Finalizer* finalizer = m_finalizerList;
+				m_finalizerList = finalizer->next;
+
+				finalizer->destroy(finalizer->object);
+			}
+		}
+
+		size_t GetNextPageSize(const size_t memorySize)
+		{
+			const size_t pageSize = m_nextPageSize;
+
+			if (m_nextPageSize < m_policy.maxPageSize)
+			{
+				const size_t grownSize = m_nextPageSize * m_policy.growthFactor;
+				m_nextPageSize = (grownSize > m_policy.maxPageSize || grownSize < m_nextPageSize) ? m_policy.maxPageSize : grownSize;
+			}
+
+			return memorySize > pageSize ? memorySize : pageSize;
+		}
+
+		void Steal(LinearArena& other)
+		{
+			if (other.m_end.next != &other.m_end)
+			{
+				m_end.next = other.m_end.next;
+				m_end.prev = other.m_end.prev;
+				m_end.next->prev = &m_end;
+				m_end.prev->next = &m_end;
+
+				m_current = (other.m_current == &other.m_end) ? &m_end : other.m_current;
+
+				other.m_end.next = &other.m_end;
+				other.m_end.prev = &other.m_end;
+				other.m_current = &other.m_end;
+			}
+
+			m_usedSize = other.m_usedSize;
+			m_peakSize = other.m_peakSize;
+
+			other.m_usedSize = 0;
+			other.m_peakSize = 0;
+
+			m_lastBlock = other.m_lastBlock;
+			m_lastOffset = other.m_lastOffset;
+
+			other.m_lastBlock = nullptr;
+
+			m_finalizerList = other.m_finalizerList;
+
+			other.m_finalizerList = nullptr;
+
+			m_policy = other.m_policy;
+			m_nextPageSize = other.m_nextPageSize;
+
+			other.m_nextPageSize = other.m_policy.initialSize;
+		}
+
 		void Release()
 		{
+			Finalize(nullptr);
+
 			Page* now = m_end.next;
 			while (nullptr != now && &m_end != now)
 			{
 				Page* next = now->next;
 
-				if (nullptr != now->data)
-				{
-					now->~Page();
-				}
+				DestroyPage(now);
 
 				now = next;
 			}
+
+			m_end.next = &m_end;
+			m_end.prev = &m_end;
+			m_current = &m_end;
+			m_lastBlock = nullptr;
+
+			m_nextPageSize = m_policy.initialSize;
 		}
 
 	private:
 		Page m_end;
+		Page* m_current;
+
+		size_t m_usedSize;
+		size_t m_peakSize;
+
+		// Start of the most recent block and the page offset before it, so it can be freed or resized
+		uint8_t* m_lastBlock;
+		size_t m_lastOffset;
+
+		Finalizer* m_finalizerList;
+
+		GrowthPolicy m_policy;
+		size_t m_nextPageSize;
 	};
 };
 
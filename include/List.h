@@ -5,12 +5,18 @@
 #include <utility>
 #include <new>
 #include <cstddef>
+#include <initializer_list>
+#include <type_traits>
 
-#include <Reflection/include/Utils.h>
+#include "HeapAllocator.h"
+#include "TypeTraits.h"
 
 namespace wtr
 {
-	template<typename T>
+	// Nodes come from the allocator one at a time. The default goes to the global heap like a plain new,
+	// aligned for T even when T is over-aligned, a PoolAllocator<List<T>::NODE_SIZE> keeps them in slabs,
+	// and Arena is opt-in for its size classes.
+	template<typename T, typename Allocator = HeapAllocator<alignof(T)>>
 	class List
 	{
 	private:
@@ -43,6 +49,16 @@ namespace wtr
 				: NodeBase(other)
 				, item(other.item)
 			{}
+
+			explicit Node(const T& item)
+				: NodeBase()
+				, item(item)
+			{}
+
+			explicit Node(T&& item)
+				: NodeBase()
+				, item(std::move(item))
+			{}
 		};
 
 	public:
@@ -52,6 +68,7 @@ namespace wtr
 		public :
 			using BaseType = std::conditional_t<Const, const NodeBase, NodeBase>;
 			using NodeType = std::conditional_t<Const, const Node, Node>;
+			using ValueType = std::conditional_t<Const, const T, T>;
 
 		public:
 			BaseIterator(BaseType* node)
@@ -112,7 +129,7 @@ namespace wtr
 				return m_node != other.m_node;
 			}
 
-			T* operator->() const
+			ValueType* operator->() const
 			{
 				assert(nullptr != m_node && "The list iterator's node is invalid");
 
@@ -120,7 +137,7 @@ namespace wtr
 				return &(node->item);
 			}
 
-			T& operator*() const
+			ValueType& operator*() const
 			{
 				assert(nullptr != m_node && "The list iterator's node is invalid");
 
@@ -140,10 +157,26 @@ namespace wtr
 		using ReverseIterator = BaseIterator<false, true>;
 		using ConstReverseIterator = BaseIterator<true, true>;
 
+	public:
+		using ValueType = T;
+		using AllocatorType = Allocator;
+
+		static constexpr size_t NODE_SIZE = sizeof(Node);
+
 	public:
 		List()
 			: m_end()
 			, m_count(0)
+			, m_allocator()
+		{
+			m_end.prev = &m_end;
+			m_end.next = &m_end;
+		}
+
+		explicit List(AllocatorType allocator)
+			: m_end()
+			, m_count(0)
+			, m_allocator(std::move(allocator))
 		{
 			m_end.prev = &m_end;
 			m_end.next = &m_end;
@@ -157,12 +190,24 @@ namespace wtr
 			}
 		}
 
-		List(const List<T>& other) = delete;
+		List(const List& other) = delete;
 
-		explicit List(List<T>&& other) noexcept
-			: List()
+		explicit List(List&& other) noexcept(std::is_move_constructible_v<Allocator>)
+			: m_end()
+			, m_count(0)
+			, m_allocator(SelectMovedAllocator(other.m_allocator))
 		{
-			this->Splice(Begin(), other);
+			m_end.prev = &m_end;
+			m_end.next = &m_end;
+
+			if constexpr (std::is_move_constructible_v<Allocator>)
+			{
+				SpliceNodes(Begin(), other);
+			}
+			else
+			{
+				MoveElements(other);
+			}
 		}
 
 		~List()
@@ -170,14 +215,23 @@ namespace wtr
 			Clear();
 		}
 
-		List& operator=(const List<T>& other) = delete;
+		List& operator=(const List& other) = delete;
 
-		List& operator=(List<T>&& other) noexcept
+		List& operator=(List&& other)
 		{
 			if (this != &other)
 			{
 				Clear();
-				this->Splice(End(), other);
+
+				if constexpr (std::is_move_assignable_v<Allocator>)
+				{
+					m_allocator = std::move(other.m_allocator);
+					SpliceNodes(End(), other);
+				}
+				else
+				{
+					MoveElements(other);
+				}
 			}
 
 			return *this;
@@ -241,52 +295,49 @@ namespace wtr
 			Erase(back);
 		}
 
-		void Splice(const Iterator pos, List<T>& other)
+		// Nodes are only relinked when both lists share one allocator, like two equal AllocatorRefs,
+		// otherwise the items are moved into nodes from this list's allocator.
+		// Returns false when a node could not be allocated, the items not moved yet stay in the other list.
+		bool Splice(const Iterator pos, List& other)
 		{
 			if (this == &other || other.Empty())
 			{
-				return;
+				return true;
 			}
 
-			NodeBase* node = pos.m_node;
-			if (nullptr == node || nullptr == node->prev || nullptr == node->next)
+			if (!SharesAllocator(other))
 			{
-				return;
+				return Transfer(pos, other, other.Begin(), other.End());
 			}
 
-			NodeBase* prev = node->prev;
-			NodeBase* head = other.m_end.next;
-			NodeBase* tail = other.m_end.prev;
-
-			prev->next = head;
-			head->prev = prev;
+			SpliceNodes(pos, other);
 
-			node->prev = tail;
-			tail->next = node;
-
-			other.m_end.next = &other.m_end;
-			other.m_end.prev = &other.m_end;
-			m_count += other.m_count;
-			other.m_count = 0;
+			return true;
 		}
 
-		void Splice(const Iterator pos, List<T>& other, const Iterator itr)
+		bool Splice(const Iterator pos, List& other, const Iterator itr)
 		{
 			if (pos == itr || other.Empty())
 			{
-				return;
+				return true;
+			}
+
+			if (!SharesAllocator(other))
+			{
+				Iterator next = itr;
+				return Transfer(pos, other, itr, ++next);
 			}
 
 			NodeBase* node = pos.m_node;
 			if (nullptr == node || nullptr == node->prev)
 			{
-				return;
+				return true;
 			}
 
 			NodeBase* otherNode = itr.m_node;
 			if (nullptr == otherNode || nullptr == otherNode->prev || nullptr == otherNode->next)
 			{
-				return;
+				return true;
 			}
 
 			NodeBase* otherPrev = otherNode->prev;
@@ -304,19 +355,26 @@ namespace wtr
 
 			other.m_count--;
 			m_count++;
+
+			return true;
 		}
 
-		void Splice(const Iterator pos, List<T>& other, const Iterator first, const Iterator last)
+		bool Splice(const Iterator pos, List& other, const Iterator first, const Iterator last)
 		{
 			if (pos == last || first == last)
 			{
-				return;
+				return true;
+			}
+
+			if (!SharesAllocator(other))
+			{
+				return Transfer(pos, other, first, last);
 			}
 
 			NodeBase* node = pos.m_node;
 			if (nullptr == node || nullptr == node->prev)
 			{
-				return;
+				return true;
 			}
 
 			NodeBase* firstNode = first.m_node;
@@ -324,7 +382,7 @@ namespace wtr
 			if (nullptr == firstNode || nullptr == firstNode->prev ||
 				nullptr == endNode || nullptr == endNode->next)
 			{
-				return;
+				return true;
 			}
 
 			NodeBase* firstPrev = firstNode->prev;
@@ -333,7 +391,7 @@ namespace wtr
 			firstPrev->next = lastNext;
 			lastNext->prev = firstPrev;
 
-			Node* prev = node->prev;
+			NodeBase* prev = node->prev;
 
 			prev->next = firstNode;
 			firstNode->prev = prev;
@@ -351,6 +409,8 @@ namespace wtr
 					current = current->next;
 				}
 			}
+
+			return true;
 		}
 
 		void Remove(const T& item)
@@ -391,29 +451,12 @@ namespace wtr
 	public :
 		Iterator Insert(Iterator pos, const T& item)
 		{
-			NodeBase* node = pos.m_node;
-			if (nullptr == node || nullptr == node->prev || nullptr == node->next)
-			{
-				return End();
-			}
-
-			NodeBase* prev = node->prev;
-			Node* newNode = new (std::nothrow) Node;
-			if (nullptr == newNode)
-			{
-				return End();
-			}
-
-			newNode->item = item;
-			newNode->prev = prev;
-			newNode->next = node;
-
-			prev->next = static_cast<NodeBase*>(newNode);
-			node->prev = static_cast<NodeBase*>(newNode);
-
-			m_count++;
+			return InsertNode(pos, item);
+		}
 
-			return Iterator(newNode);
+		Iterator Insert(Iterator pos, T&& item)
+		{
+			return InsertNode(pos, std::move(item));
 		}
 
 		Iterator Erase(const Iterator itr)
@@ -437,7 +480,8 @@ namespace wtr
 
 			m_count--;
 
-			delete node;
+			static_cast<Node*>(node)->~Node();
+			m_allocator.Deallocate(static_cast<void*>(node));
 
 			return Iterator(next);
 		}
@@ -445,7 +489,7 @@ namespace wtr
 		Iterator Find(const T& item)
 		{
 			NodeBase* node = m_end.next;
-			while (node != m_end)
+			while (node != &m_end)
 			{
 				const T& nodeItem = static_cast<Node*>(node)->item;
 				if (nodeItem == item)
@@ -464,7 +508,7 @@ namespace wtr
 		Iterator begin() { return Iterator(m_end.next); }
 		Iterator end() { return Iterator(&m_end); }
 		ConstIterator begin() const { return ConstIterator(m_end.next); }
-		ConstIterator end() const {	return Iterator(&m_end); }
+		ConstIterator end() const {	return ConstIterator(&m_end); }
 
 		ReverseIterator rbegin() { return ReverseIterator(m_end.prev); }
 		ReverseIterator rend() { return ReverseIterator(&m_end); }
@@ -482,9 +526,118 @@ namespace wtr
 		ConstReverseIterator rBegin() const { return ConstReverseIterator(m_end.prev); }
 		ConstReverseIterator rEnd() const {	return ConstReverseIterator(&m_end); }
 
+		AllocatorType& GetAllocator()
+		{
+			return m_allocator;
+		}
+
+		const AllocatorType& GetAllocator() const
+		{
+			return m_allocator;
+		}
+
+	private :
+		bool SharesAllocator(const List& other) const
+		{
+			if constexpr (std::is_copy_constructible_v<Allocator> && IsEqualityComparable<Allocator>::value)
+			{
+				return this == &other || m_allocator == other.m_allocator;
+			}
+			else
+			{
+				return this == &other;
+			}
+		}
+
+		template<typename Item>
+		Iterator InsertNode(Iterator pos, Item&& item)
+		{
+			NodeBase* node = pos.m_node;
+			if (nullptr == node || nullptr == node->prev || nullptr == node->next)
+			{
+				return End();
+			}
+
+			NodeBase* prev = node->prev;
+
+			void* memory = m_allocator.Allocate(sizeof(Node), alignof(Node));
+			if (nullptr == memory)
+			{
+				return End();
+			}
+
+			Node* newNode = new (memory) Node(std::forward<Item>(item));
+			newNode->prev = prev;
+			newNode->next = node;
+
+			prev->next = static_cast<NodeBase*>(newNode);
+			node->prev = static_cast<NodeBase*>(newNode);
+
+			m_count++;
+
+			return Iterator(newNode);
+		}
+
+		// Relink every node of the other list, the nodes must be freeable by this list's allocator
+		void SpliceNodes(const Iterator pos, List& other)
+		{
+			if (other.Empty())
+			{
+				return;
+			}
+
+			NodeBase* node = pos.m_node;
+			if (nullptr == node || nullptr == node->prev || nullptr == node->next)
+			{
+				return;
+			}
+
+			NodeBase* prev = node->prev;
+			NodeBase* head = other.m_end.next;
+			NodeBase* tail = other.m_end.prev;
+
+			prev->next = head;
+			head->prev = prev;
+
+			node->prev = tail;
+			tail->next = node;
+
+			other.m_end.next = &other.m_end;
+			other.m_end.prev = &other.m_end;
+			m_count += other.m_count;
+			other.m_count = 0;
+		}
+
+		// Move the items in [first, last) of a list with another allocator in front of pos.
+		// The item is only moved from once its new node is allocated, so a failed insert leaves it, and the rest, in the other list.
+		bool Transfer(const Iterator pos, List& other, Iterator first, const Iterator last)
+		{
+			while (first != last)
+			{
+				if (End() == InsertNode(pos, std::move(*first)))
+				{
+					return false;
+				}
+
+				first = other.Erase(first);
+			}
+
+			return true;
+		}
+
+		// The allocator can not be moved, so the other list keeps its nodes and the items are moved one by one
+		void MoveElements(List& other)
+		{
+			const bool moved = Transfer(End(), other, other.Begin(), other.End());
+
+			assert(moved && "Failed to allocate a node, the items not moved stay in the other list");
+			(void)moved;
+		}
+
 	private:
 		NodeBase m_end;
 		size_t m_count;
+		AllocatorType m_allocator;
 	};
 };
 
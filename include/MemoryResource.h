@@ -0,0 +1,155 @@
+#ifndef __WTR_MEMORYRESOURCE_H__
+#define __WTR_MEMORYRESOURCE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory_resource>
+
+#include "Arena.h"
+#include "TypeTraits.h"
+
+namespace wtr
+{
+	// Expose a wtr allocator, like Arena or LinearArena, as a std::pmr::memory_resource.
+	// Deallocate is forwarded only when the allocator has one, so a linear arena frees everything on Reset.
+	template<typename Allocator = Arena>
+	class AllocatorResource : public std::pmr::memory_resource
+	{
+	public :
+		using AllocatorType = Allocator;
+
+		explicit AllocatorResource(Allocator& allocator)
+			: m_allocator(&allocator)
+		{}
+
+		AllocatorResource(const AllocatorResource& other) = default;
+
+		~AllocatorResource() override = default;
+
+		AllocatorResource& operator=(const AllocatorResource& other) = default;
+
+		Allocator* Get() const
+		{
+			return m_allocator;
+		}
+
+	private :
+		void* do_allocate(size_t memorySize, size_t alignSize) override
+		{
+			void* memory = m_allocator->Allocate(memorySize, alignSize);
+			if (nullptr == memory)
+			{
+				throw std::bad_alloc();
+			}
+
+			return memory;
+		}
+
+		void do_deallocate(void* pointer, size_t memorySize, size_t alignSize) override
+		{
+			(void)memorySize;
+			(void)alignSize;
+
+			if constexpr (HasDeallocate<Allocator>::value)
+			{
+				m_allocator->Deallocate(pointer);
+			}
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			const AllocatorResource* resource = dynamic_cast<const AllocatorResource*>(&other);
+
+			return nullptr != resource && resource->m_allocator == m_allocator;
+		}
+
+	private :
+		Allocator* m_allocator;
+	};
+
+	// Use any std::pmr::memory_resource as a wtr container's allocator.
+	// memory_resource needs the size and alignment back on deallocate, so both are kept right before the returned memory.
+	class ResourceAllocator
+	{
+	private :
+		struct Header
+		{
+			size_t totalSize;
+			size_t alignSize;
+		};
+
+	public :
+		ResourceAllocator()
+			: m_resource(std::pmr::get_default_resource())
+		{}
+
+		ResourceAllocator(std::pmr::memory_resource* resource)
+			: m_resource(resource)
+		{}
+
+		ResourceAllocator(const ResourceAllocator& other) = default;
+
+		~ResourceAllocator() = default;
+
+		ResourceAllocator& operator=(const ResourceAllocator& other) = default;
+
+		bool operator==(const ResourceAllocator& other) const
+		{
+			return m_resource == other.m_resource || m_resource->is_equal(*other.m_resource);
+		}
+
+		bool operator!=(const ResourceAllocator& other) const
+		{
+			return !(*this == other);
+		}
+
+	public :
+		void* Allocate(const size_t memorySize, const size_t alignSize = alignof(std::max_align_t))
+		{
+			const size_t blockAlignSize = alignSize > alignof(Header) ? alignSize : alignof(Header);
+			const size_t headerSize = GetHeaderSize(blockAlignSize);
+			const size_t totalSize = headerSize + memorySize;
+
+			uint8_t* memory = static_cast<uint8_t*>(m_resource->allocate(totalSize, blockAlignSize));
+
+			Header* header = reinterpret_cast<Header*>(memory + headerSize) - 1;
+			header->totalSize = totalSize;
+			header->alignSize = blockAlignSize;
+
+			return static_cast<void*>(memory + headerSize);
+		}
+
+		void Deallocate(void* pointer)
+		{
+			if (nullptr == pointer)
+			{
+				return;
+			}
+
+			const Header* header = static_cast<const Header*>(pointer) - 1;
+			const size_t totalSize = header->totalSize;
+			const size_t alignSize = header->alignSize;
+
+			uint8_t* memory = static_cast<uint8_t*>(pointer) - GetHeaderSize(alignSize);
+
+			m_resource->deallocate(static_cast<void*>(memory), totalSize, alignSize);
+		}
+
+		std::pmr::memory_resource* GetResource() const
+		{
+			return m_resource;
+		}
+
+	private :
+		static size_t GetHeaderSize(const size_t alignSize)
+		{
+			return (sizeof(Header) + alignSize - 1) / alignSize * alignSize;
+		}
+
+	private :
+		std::pmr::memory_resource* m_resource;
+	};
+};
+
+#endif // __WTR_MEMORYRESOURCE_H__
\ No newline at end of file
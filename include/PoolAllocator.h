@@ -0,0 +1,180 @@
+#ifndef __WTR_POOLALLOCATOR_H__
+#define __WTR_POOLALLOCATOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <new>
+
+namespace wtr
+{
+	// Allocator of fixed size blocks, carved from slabs and recycled through an intrusive free list.
+	// Allocate and Deallocate are O(1), and blocks freed together are handed out again together.
+	// Every block is at least BlockSize large and aligned to BLOCK_ALIGN_SIZE, larger requests fail.
+	template<size_t BlockSize, size_t SlabSize = 64 * 1024>
+	class PoolAllocator
+	{
+		private :
+			struct FreeBlock
+			{
+				FreeBlock* next;
+			};
+
+			struct alignas(std::max_align_t) Slab
+			{
+				Slab* next;
+			};
+
+			static constexpr size_t AlignUp(const size_t value, const size_t alignSize)
+			{
+				return (value + alignSize - 1) / alignSize * alignSize;
+			}
+
+			// The lowest set bit of the stride is the alignment every block keeps
+			static constexpr size_t GetBlockAlignSize(const size_t stride)
+			{
+				const size_t alignSize = stride & (~stride + 1);
+
+				return alignSize < alignof(Slab) ? alignSize : alignof(Slab);
+			}
+
+		public :
+			static constexpr size_t BLOCK_SIZE = AlignUp(BlockSize > sizeof(FreeBlock) ? BlockSize : sizeof(FreeBlock), alignof(FreeBlock));
+			static constexpr size_t BLOCK_ALIGN_SIZE = GetBlockAlignSize(BLOCK_SIZE);
+			static constexpr size_t BLOCK_COUNT = (SlabSize - sizeof(Slab)) / BLOCK_SIZE;
+
+			static_assert(0 < BLOCK_COUNT, "The pool allocator's slab must hold at least one block");
+
+			PoolAllocator()
+				: m_freeList(nullptr)
+				, m_slabList(nullptr)
+				, m_cursor(nullptr)
+				, m_cursorEnd(nullptr)
+			{}
+
+			PoolAllocator(const PoolAllocator& other) = delete;
+			PoolAllocator(PoolAllocator&& other) noexcept
+				: PoolAllocator()
+			{
+				Steal(other);
+			}
+
+			~PoolAllocator()
+			{
+				Release();
+			}
+
+			PoolAllocator& operator=(const PoolAllocator& other) = delete;
+			PoolAllocator& operator=(PoolAllocator&& other) noexcept
+			{
+				if (this != &other)
+				{
+					Release();
+					Steal(other);
+				}
+
+				return *this;
+			}
+
+		public :
+			void* Allocate(const size_t memorySize = BlockSize, const size_t alignSize = BLOCK_ALIGN_SIZE)
+			{
+				assert(memorySize <= BLOCK_SIZE && alignSize <= BLOCK_ALIGN_SIZE && "The request does not fit the pool allocator's block");
+				if (memorySize > BLOCK_SIZE || alignSize > BLOCK_ALIGN_SIZE)
+				{
+					return nullptr;
+				}
+
+				if (nullptr != m_freeList)
+				{
+					FreeBlock* block = m_freeList;
+					m_freeList = block->next;
+
+					return static_cast<void*>(block);
+				}
+
+				// The newest slab is carved lazily, so blocks are handed out in address order
+				if (m_cursor == m_cursorEnd && !CreateSlab())
+				{
+					return nullptr;
+				}
+
+				void* block = static_cast<void*>(m_cursor);
+				m_cursor += BLOCK_SIZE;
+
+				return block;
+			}
+
+			void Deallocate(void* pointer)
+			{
+				if (nullptr == pointer)
+				{
+					return;
+				}
+
+				FreeBlock* block = static_cast<FreeBlock*>(pointer);
+				block->next = m_freeList;
+				m_freeList = block;
+			}
+
+		private :
+			bool CreateSlab()
+			{
+				void* memory = ::operator new(sizeof(Slab) + BLOCK_COUNT * BLOCK_SIZE, std::nothrow);
+				if (nullptr == memory)
+				{
+					return false;
+				}
+
+				Slab* newSlab = new (memory) Slab();
+				newSlab->next = m_slabList;
+				m_slabList = newSlab;
+
+				m_cursor = reinterpret_cast<uint8_t*>(newSlab) + sizeof(Slab);
+				m_cursorEnd = m_cursor + BLOCK_COUNT * BLOCK_SIZE;
+
+				return true;
+			}
+
+			void Steal(PoolAllocator& other)
+			{
+				m_freeList = other.m_freeList;
+				m_slabList = other.m_slabList;
+				m_cursor = other.m_cursor;
+				m_cursorEnd = other.m_cursorEnd;
+
+				other.m_freeList = nullptr;
+				other.m_slabList = nullptr;
+				other.m_cursor = nullptr;
+				other.m_cursorEnd = nullptr;
+			}
+
+			void Release()
+			{
+				Slab* now = m_slabList;
+				while (nullptr != now)
+				{
+					Slab* next = now->next;
+
+					now->~Slab();
+					::operator delete(static_cast<void*>(now));
+
+					now = next;
+				}
+
+				m_freeList = nullptr;
+				m_slabList = nullptr;
+				m_cursor = nullptr;
+				m_cursorEnd = nullptr;
+			}
+
+		private :
+			FreeBlock* m_freeList;
+			Slab* m_slabList;
+
+			uint8_t* m_cursor;
+			uint8_t* m_cursorEnd;
+	};
+};
+
+#endif // __WTR_POOLALLOCATOR_H__
\ No newline at end of file
@@ -0,0 +1,733 @@
+#ifndef __WTR_SIMD_H__
+#define __WTR_SIMD_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+
+	#define WTR_SIMD_USE_AVX2 1
+	#define WTR_SIMD_USE_SSE2 0
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+
+	#define WTR_SIMD_USE_AVX2 0
+	#define WTR_SIMD_USE_SSE2 1
+#else
+	#define WTR_SIMD_USE_AVX2 0
+	#define WTR_SIMD_USE_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace wtr
+{
+	// Vector operations of one element type, every comparison returns a SimdMask with all bits of a matching lane set.
+	// ENABLED is false for types without a kernel, and ORDERED is false when only equality has one.
+	template<typename T, typename = void>
+	struct SimdTraits
+	{
+		static constexpr bool ENABLED = false;
+		static constexpr bool ORDERED = false;
+	};
+
+#if WTR_SIMD_USE_AVX2
+	// Lane masks of every element type share one integer vector, so they combine and count the same way
+	struct SimdMask
+	{
+		using Type = __m256i;
+
+		static constexpr size_t VECTOR_SIZE = 32;
+
+		static Type And(const Type lhs, const Type rhs) { return _mm256_and_si256(lhs, rhs); }
+		static Type Or(const Type lhs, const Type rhs) { return _mm256_or_si256(lhs, rhs); }
+		static Type Not(const Type mask) { return _mm256_xor_si256(mask, _mm256_set1_epi32(-1)); }
+		static uint32_t ToBits(const Type mask) { return static_cast<uint32_t>(_mm256_movemask_epi8(mask)); }
+
+		// Every byte of a matching lane counts up by one, a byte counter holds at most COUNT_LIMIT vectors
+		static constexpr size_t COUNT_LIMIT = 255;
+
+		static Type Zero() { return _mm256_setzero_si256(); }
+		static Type AddCount(const Type counter, const Type mask) { return _mm256_sub_epi8(counter, mask); }
+
+		static size_t SumCount(const Type counter)
+		{
+			const __m256i sums = _mm256_sad_epu8(counter, _mm256_setzero_si256());
+			const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+
+			return static_cast<size_t>(_mm_cvtsi128_si32(half)) + static_cast<size_t>(_mm_cvtsi128_si32(_mm_unpackhi_epi64(half, half)));
+		}
+	};
+
+	template<typename T>
+	struct SimdTraits<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+	{
+		using VectorType = __m256i;
+
+		using Mask = SimdMask;
+
+		static constexpr bool ENABLED = true;
+		static constexpr bool ORDERED = true;
+
+		static VectorType Load(const T* data)
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+		}
+
+		static VectorType Set(const T value)
+		{
+			if constexpr (1 == sizeof(T)) { return _mm256_set1_epi8(static_cast<char>(value)); }
+			else if constexpr (2 == sizeof(T)) { return _mm256_set1_epi16(static_cast<short>(value)); }
+			else if constexpr (4 == sizeof(T)) { return _mm256_set1_epi32(static_cast<int>(value)); }
+			else { return _mm256_set1_epi64x(static_cast<long long>(value)); }
+		}
+
+		static SimdMask::Type Equal(const VectorType lhs, const VectorType rhs)
+		{
+			if constexpr (1 == sizeof(T)) { return _mm256_cmpeq_epi8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T)) { return _mm256_cmpeq_epi16(lhs, rhs); }
+			else if constexpr (4 == sizeof(T)) { return _mm256_cmpeq_epi32(lhs, rhs); }
+			else { return _mm256_cmpeq_epi64(lhs, rhs); }
+		}
+
+		// Only signed compares exist, so unsigned lanes are biased by the sign bit first
+		static SimdMask::Type Greater(VectorType lhs, VectorType rhs)
+		{
+			if constexpr (std::is_unsigned_v<T>)
+			{
+				const VectorType bias = Set(static_cast<T>(T(1) << (sizeof(T) * 8 - 1)));
+				lhs = _mm256_xor_si256(lhs, bias);
+				rhs = _mm256_xor_si256(rhs, bias);
+			}
+
+			if constexpr (1 == sizeof(T)) { return _mm256_cmpgt_epi8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T)) { return _mm256_cmpgt_epi16(lhs, rhs); }
+			else if constexpr (4 == sizeof(T)) { return _mm256_cmpgt_epi32(lhs, rhs); }
+			else { return _mm256_cmpgt_epi64(lhs, rhs); }
+		}
+
+		static SimdMask::Type GreaterEqual(const VectorType lhs, const VectorType rhs)
+		{
+			return SimdMask::Not(Greater(rhs, lhs));
+		}
+
+		static VectorType Min(const VectorType lhs, const VectorType rhs)
+		{
+			if constexpr (1 == sizeof(T)) { return std::is_signed_v<T> ? _mm256_min_epi8(lhs, rhs) : _mm256_min_epu8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T)) { return std::is_signed_v<T> ? _mm256_min_epi16(lhs, rhs) : _mm256_min_epu16(lhs, rhs); }
+			else if constexpr (4 == sizeof(T)) { return std::is_signed_v<T> ? _mm256_min_epi32(lhs, rhs) : _mm256_min_epu32(lhs, rhs); }
+			else { return _mm256_blendv_epi8(lhs, rhs, Greater(lhs, rhs)); }
+		}
+
+		static VectorType Max(const VectorType lhs, const VectorType rhs)
+		{
+			if constexpr (1 == sizeof(T)) { return std::is_signed_v<T> ? _mm256_max_epi8(lhs, rhs) : _mm256_max_epu8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T)) { return std::is_signed_v<T> ? _mm256_max_epi16(lhs, rhs) : _mm256_max_epu16(lhs, rhs); }
+			else if constexpr (4 == sizeof(T)) { return std::is_signed_v<T> ? _mm256_max_epi32(lhs, rhs) : _mm256_max_epu32(lhs, rhs); }
+			else { return _mm256_blendv_epi8(rhs, lhs, Greater(lhs, rhs)); }
+		}
+
+		static void Store(T* data, const VectorType vector)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(data), vector);
+		}
+	};
+
+	template<>
+	struct SimdTraits<float>
+	{
+		using VectorType = __m256;
+
+		using Mask = SimdMask;
+
+		static constexpr bool ENABLED = true;
+		static constexpr bool ORDERED = true;
+
+		static VectorType Load(const float* data) { return _mm256_loadu_ps(data); }
+		static VectorType Set(const float value) { return _mm256_set1_ps(value); }
+		static void Store(float* data, const VectorType vector) { _mm256_storeu_ps(data, vector); }
+
+		static SimdMask::Type Equal(const VectorType lhs, const VectorType rhs) { return _mm256_castps_si256(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ)); }
+		static SimdMask::Type Greater(const VectorType lhs, const VectorType rhs) { return _mm256_castps_si256(_mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ)); }
+		static SimdMask::Type GreaterEqual(const VectorType lhs, const VectorType rhs) { return _mm256_castps_si256(_mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ)); }
+
+		static VectorType Min(const VectorType lhs, const VectorType rhs) { return _mm256_min_ps(lhs, rhs); }
+		static VectorType Max(const VectorType lhs, const VectorType rhs) { return _mm256_max_ps(lhs, rhs); }
+	};
+
+	template<>
+	struct SimdTraits<double>
+	{
+		using VectorType = __m256d;
+
+		using Mask = SimdMask;
+
+		static constexpr bool ENABLED = true;
+		static constexpr bool ORDERED = true;
+
+		static VectorType Load(const double* data) { return _mm256_loadu_pd(data); }
+		static VectorType Set(const double value) { return _mm256_set1_pd(value); }
+		static void Store(double* data, const VectorType vector) { _mm256_storeu_pd(data, vector); }
+
+		static SimdMask::Type Equal(const VectorType lhs, const VectorType rhs) { return _mm256_castpd_si256(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ)); }
+		static SimdMask::Type Greater(const VectorType lhs, const VectorType rhs) { return _mm256_castpd_si256(_mm256_cmp_pd(lhs, rhs, _CMP_GT_OQ)); }
+		static SimdMask::Type GreaterEqual(const VectorType lhs, const VectorType rhs) { return _mm256_castpd_si256(_mm256_cmp_pd(lhs, rhs, _CMP_GE_OQ)); }
+
+		static VectorType Min(const VectorType lhs, const VectorType rhs) { return _mm256_min_pd(lhs, rhs); }
+		static VectorType Max(const VectorType lhs, const VectorType rhs) { return _mm256_max_pd(lhs, rhs); }
+	};
+#elif WTR_SIMD_USE_SSE2
+	// Lane masks of every element type share one integer vector, so they combine and count the same way
+	struct SimdMask
+	{
+		using Type = __m128i;
+
+		static constexpr size_t VECTOR_SIZE = 16;
+
+		static Type And(const Type lhs, const Type rhs) { return _mm_and_si128(lhs, rhs); }
+		static Type Or(const Type lhs, const Type rhs) { return _mm_or_si128(lhs, rhs); }
+		static Type Not(const Type mask) { return _mm_xor_si128(mask, _mm_set1_epi32(-1)); }
+		static uint32_t ToBits(const Type mask) { return static_cast<uint32_t>(_mm_movemask_epi8(mask)); }
+
+		// Every byte of a matching lane counts up by one, a byte counter holds at most COUNT_LIMIT vectors
+		static constexpr size_t COUNT_LIMIT = 255;
+
+		static Type Zero() { return _mm_setzero_si128(); }
+		static Type AddCount(const Type counter, const Type mask) { return _mm_sub_epi8(counter, mask); }
+
+		static size_t SumCount(const Type counter)
+		{
+			const __m128i sums = _mm_sad_epu8(counter, _mm_setzero_si128());
+
+			return static_cast<size_t>(_mm_cvtsi128_si32(sums)) + static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+		}
+	};
+
+	template<typename T>
+	struct SimdTraits<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+	{
+		using VectorType = __m128i;
+
+		using Mask = SimdMask;
+
+		static constexpr bool ENABLED = true;
+		// SSE2 has no 64-bit lane compare, so those only get equality
+		static constexpr bool ORDERED = (8 != sizeof(T));
+
+		static VectorType Load(const T* data)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		}
+
+		static VectorType Set(const T value)
+		{
+			if constexpr (1 == sizeof(T)) { return _mm_set1_epi8(static_cast<char>(value)); }
+			else if constexpr (2 == sizeof(T)) { return _mm_set1_epi16(static_cast<short>(value)); }
+			else if constexpr (4 == sizeof(T)) { return _mm_set1_epi32(static_cast<int>(value)); }
+			else { return _mm_set1_epi64x(static_cast<long long>(value)); }
+		}
+
+		static SimdMask::Type Equal(const VectorType lhs, const VectorType rhs)
+		{
+			if constexpr (1 == sizeof(T)) { return _mm_cmpeq_epi8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T)) { return _mm_cmpeq_epi16(lhs, rhs); }
+			else if constexpr (4 == sizeof(T)) { return _mm_cmpeq_epi32(lhs, rhs); }
+			else
+			{
+				// A 64-bit lane is equal when both of its 32-bit halves are
+				const VectorType equal = _mm_cmpeq_epi32(lhs, rhs);
+				return _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+		}
+
+		// Only signed compares exist, so unsigned lanes are biased by the sign bit first
+		static SimdMask::Type Greater(VectorType lhs, VectorType rhs)
+		{
+			static_assert(8 != sizeof(T), "SSE2 has no 64-bit lane compare");
+
+			if constexpr (std::is_unsigned_v<T>)
+			{
+				const VectorType bias = Set(static_cast<T>(T(1) << (sizeof(T) * 8 - 1)));
+				lhs = _mm_xor_si128(lhs, bias);
+				rhs = _mm_xor_si128(rhs, bias);
+			}
+
+			if constexpr (1 == sizeof(T)) { return _mm_cmpgt_epi8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T)) { return _mm_cmpgt_epi16(lhs, rhs); }
+			else { return _mm_cmpgt_epi32(lhs, rhs); }
+		}
+
+		static SimdMask::Type GreaterEqual(const VectorType lhs, const VectorType rhs)
+		{
+			return SimdMask::Not(Greater(rhs, lhs));
+		}
+
+		static VectorType Min(const VectorType lhs, const VectorType rhs)
+		{
+			if constexpr (1 == sizeof(T) && std::is_unsigned_v<T>) { return _mm_min_epu8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T) && std::is_signed_v<T>) { return _mm_min_epi16(lhs, rhs); }
+			else { return Select(Greater(lhs, rhs), rhs, lhs); }
+		}
+
+		static VectorType Max(const VectorType lhs, const VectorType rhs)
+		{
+			if constexpr (1 == sizeof(T) && std::is_unsigned_v<T>) { return _mm_max_epu8(lhs, rhs); }
+			else if constexpr (2 == sizeof(T) && std::is_signed_v<T>) { return _mm_max_epi16(lhs, rhs); }
+			else { return Select(Greater(lhs, rhs), lhs, rhs); }
+		}
+
+		static void Store(T* data, const VectorType vector)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data), vector);
+		}
+
+	private :
+		static VectorType Select(const VectorType mask, const VectorType onTrue, const VectorType onFalse)
+		{
+			return _mm_or_si128(_mm_and_si128(mask, onTrue), _mm_andnot_si128(mask, onFalse));
+		}
+	};
+
+	template<>
+	struct SimdTraits<float>
+	{
+		using VectorType = __m128;
+
+		using Mask = SimdMask;
+
+		static constexpr bool ENABLED = true;
+		static constexpr bool ORDERED = true;
+
+		static VectorType Load(const float* data) { return _mm_loadu_ps(data); }
+		static VectorType Set(const float value) { return _mm_set1_ps(value); }
+		static void Store(float* data, const VectorType vector) { _mm_storeu_ps(data, vector); }
+
+		static SimdMask::Type Equal(const VectorType lhs, const VectorType rhs) { return _mm_castps_si128(_mm_cmpeq_ps(lhs, rhs)); }
+		static SimdMask::Type Greater(const VectorType lhs, const VectorType rhs) { return _mm_castps_si128(_mm_cmpgt_ps(lhs, rhs)); }
+		static SimdMask::Type GreaterEqual(const VectorType lhs, const VectorType rhs) { return _mm_castps_si128(_mm_cmpge_ps(lhs, rhs)); }
+
+		static VectorType Min(const VectorType lhs, const VectorType rhs) { return _mm_min_ps(lhs, rhs); }
+		static VectorType Max(const VectorType lhs, const VectorType rhs) { return _mm_max_ps(lhs, rhs); }
+	};
+
+	template<>
+	struct SimdTraits<double>
+	{
+		using VectorType = __m128d;
+
+		using Mask = SimdMask;
+
+		static constexpr bool ENABLED = true;
+		static constexpr bool ORDERED = true;
+
+		static VectorType Load(const double* data) { return _mm_loadu_pd(data); }
+		static VectorType Set(const double value) { return _mm_set1_pd(value); }
+		static void Store(double* data, const VectorType vector) { _mm_storeu_pd(data, vector); }
+
+		static SimdMask::Type Equal(const VectorType lhs, const VectorType rhs) { return _mm_castpd_si128(_mm_cmpeq_pd(lhs, rhs)); }
+		static SimdMask::Type Greater(const VectorType lhs, const VectorType rhs) { return _mm_castpd_si128(_mm_cmpgt_pd(lhs, rhs)); }
+		static SimdMask::Type GreaterEqual(const VectorType lhs, const VectorType rhs) { return _mm_castpd_si128(_mm_cmpge_pd(lhs, rhs)); }
+
+		static VectorType Min(const VectorType lhs, const VectorType rhs) { return _mm_min_pd(lhs, rhs); }
+		static VectorType Max(const VectorType lhs, const VectorType rhs) { return _mm_max_pd(lhs, rhs); }
+	};
+#endif
+
+	// Predicates FindIf and CountIf vectorize, any other callable runs the scalar loop
+	struct SimdPredicate {};
+
+	template<typename T>
+	struct EqualTo : SimdPredicate
+	{
+		using ValueType = T;
+		static constexpr bool ORDERED = false;
+
+		T value;
+
+		explicit EqualTo(const T& value) : value(value) {}
+
+		bool operator()(const T& item) const { return item == value; }
+
+		template<typename Traits>
+		auto Match(const typename Traits::VectorType vector) const { return Traits::Equal(vector, Traits::Set(value)); }
+	};
+
+	template<typename T>
+	struct NotEqualTo : SimdPredicate
+	{
+		using ValueType = T;
+		static constexpr bool ORDERED = false;
+
+		T value;
+
+		explicit NotEqualTo(const T& value) : value(value) {}
+
+		bool operator()(const T& item) const { return item != value; }
+
+		template<typename Traits>
+		auto Match(const typename Traits::VectorType vector) const { return Traits::Mask::Not(Traits::Equal(vector, Traits::Set(value))); }
+	};
+
+	template<typename T>
+	struct LessThan : SimdPredicate
+	{
+		using ValueType = T;
+		static constexpr bool ORDERED = true;
+
+		T value;
+
+		explicit LessThan(const T& value) : value(value) {}
+
+		bool operator()(const T& item) const { return item < value; }
+
+		template<typename Traits>
+		auto Match(const typename Traits::VectorType vector) const { return Traits::Greater(Traits::Set(value), vector); }
+	};
+
+	template<typename T>
+	struct LessEqual : SimdPredicate
+	{
+		using ValueType = T;
+		static constexpr bool ORDERED = true;
+
+		T value;
+
+		explicit LessEqual(const T& value) : value(value) {}
+
+		bool operator()(const T& item) const { return item <= value; }
+
+		template<typename Traits>
+		auto Match(const typename Traits::VectorType vector) const { return Traits::GreaterEqual(Traits::Set(value), vector); }
+	};
+
+	template<typename T>
+	struct GreaterThan : SimdPredicate
+	{
+		using ValueType = T;
+		static constexpr bool ORDERED = true;
+
+		T value;
+
+		explicit GreaterThan(const T& value) : value(value) {}
+
+		bool operator()(const T& item) const { return item > value; }
+
+		template<typename Traits>
+		auto Match(const typename Traits::VectorType vector) const { return Traits::Greater(vector, Traits::Set(value)); }
+	};
+
+	template<typename T>
+	struct GreaterEqual : SimdPredicate
+	{
+		using ValueType = T;
+		static constexpr bool ORDERED = true;
+
+		T value;
+
+		explicit GreaterEqual(const T& value) : value(value) {}
+
+		bool operator()(const T& item) const { return item >= value; }
+
+		template<typename Traits>
+		auto Match(const typename Traits::VectorType vector) const { return Traits::GreaterEqual(vector, Traits::Set(value)); }
+	};
+
+	// lower <= item <= upper
+	template<typename T>
+	struct InRange : SimdPredicate
+	{
+		using ValueType = T;
+		static constexpr bool ORDERED = true;
+
+		T lower;
+		T upper;
+
+		InRange(const T& lower, const T& upper) : lower(lower), upper(upper) {}
+
+		bool operator()(const T& item) const { return lower <= item && item <= upper; }
+
+		template<typename Traits>
+		auto Match(const typename Traits::VectorType vector) const
+		{
+			return Traits::Mask::And(Traits::GreaterEqual(vector, Traits::Set(lower)), Traits::GreaterEqual(Traits::Set(upper), vector));
+		}
+	};
+
+	// Search kernels over contiguous ranges, vectorized with SSE2 or AVX2 for integer and floating point elements.
+	// Other element types, and predicates which are not a SimdPredicate, run the same scalar loop over the raw pointer.
+	// Find results are indices, size when nothing matches. Min and Max are unspecified for ranges holding NaN, the vector
+	// min/max and the scalar compare treat it differently.
+	class SimdAlgorithm
+	{
+	public :
+		// Vectors handled per iteration, the kernels spell the four out so they stay in registers
+		static constexpr size_t UNROLL_COUNT = 4;
+
+		template<typename T, typename Predicate>
+		static constexpr bool IsVectorized()
+		{
+			if constexpr (std::is_base_of_v<SimdPredicate, Predicate>)
+			{
+				return SimdTraits<T>::ENABLED && std::is_same_v<typename Predicate::ValueType, T> && (!Predicate::ORDERED || SimdTraits<T>::ORDERED);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		template<typename T, typename Predicate>
+		static size_t FindIf(const T* data, const size_t size, const Predicate& predicate)
+		{
+			size_t index = 0;
+
+			if constexpr (IsVectorized<T, Predicate>())
+			{
+				using Traits = SimdTraits<T>;
+				constexpr size_t LANE_COUNT = Traits::Mask::VECTOR_SIZE / sizeof(T);
+
+				for (; index + UNROLL_COUNT * LANE_COUNT <= size; index += UNROLL_COUNT * LANE_COUNT)
+				{
+					const typename Traits::Mask::Type mask0 = predicate.template Match<Traits>(Traits::Load(data + index));
+					const typename Traits::Mask::Type mask1 = predicate.template Match<Traits>(Traits::Load(data + index + LANE_COUNT));
+					const typename Traits::Mask::Type mask2 = predicate.template Match<Traits>(Traits::Load(data + index + 2 * LANE_COUNT));
+					const typename Traits::Mask::Type mask3 = predicate.template Match<Traits>(Traits::Load(data + index + 3 * LANE_COUNT));
+
+					const typename Traits::Mask::Type anyMask = Traits::Mask::Or(Traits::Mask::Or(mask0, mask1), Traits::Mask::Or(mask2, mask3));
+					if (0 != Traits::Mask::ToBits(anyMask))
+					{
+						const uint32_t bits[UNROLL_COUNT] = { Traits::Mask::ToBits(mask0), Traits::Mask::ToBits(mask1), Traits::Mask::ToBits(mask2), Traits::Mask::ToBits(mask3) };
+						for (size_t unroll = 0; unroll < UNROLL_COUNT; unroll++)
+						{
+							if (0 != bits[unroll])
+							{
+								return index + unroll * LANE_COUNT + CountTrailingZeros(bits[unroll]) / sizeof(T);
+							}
+						}
+					}
+				}
+
+				for (; index + LANE_COUNT <= size; index += LANE_COUNT)
+				{
+					const uint32_t bits = Traits::Mask::ToBits(predicate.template Match<Traits>(Traits::Load(data + index)));
+					if (0 != bits)
+					{
+						return index + CountTrailingZeros(bits) / sizeof(T);
+					}
+				}
+			}
+
+			for (; index < size; index++)
+			{
+				if (predicate(data[index]))
+				{
+					return index;
+				}
+			}
+
+			return size;
+		}
+
+		template<typename T, typename Predicate>
+		static size_t CountIf(const T* data, const size_t size, const Predicate& predicate)
+		{
+			size_t index = 0;
+			size_t count = 0;
+
+			if constexpr (IsVectorized<T, Predicate>())
+			{
+				using Traits = SimdTraits<T>;
+				constexpr size_t LANE_COUNT = Traits::Mask::VECTOR_SIZE / sizeof(T);
+
+				// Every matching lane counts sizeof(T) bytes, and the byte counters are summed before they can overflow
+				size_t byteCount = 0;
+				while (index + LANE_COUNT <= size)
+				{
+					typename Traits::Mask::Type counter = Traits::Mask::Zero();
+
+					for (size_t block = 0; block < Traits::Mask::COUNT_LIMIT && index + LANE_COUNT <= size; block++, index += LANE_COUNT)
+					{
+						counter = Traits::Mask::AddCount(counter, predicate.template Match<Traits>(Traits::Load(data + index)));
+					}
+
+					byteCount += Traits::Mask::SumCount(counter);
+				}
+
+				count = byteCount / sizeof(T);
+			}
+
+			for (; index < size; index++)
+			{
+				if (predicate(data[index]))
+				{
+					count++;
+				}
+			}
+
+			return count;
+		}
+
+		// Only vectorized types go through EqualTo, which holds a copy of the value.
+		// Any other type compares against the reference, so move-only or heavy keys are never copied.
+		template<typename T>
+		static size_t Find(const T* data, const size_t size, const T& value)
+		{
+			if constexpr (SimdTraits<T>::ENABLED)
+			{
+				return FindIf(data, size, EqualTo<T>(value));
+			}
+			else
+			{
+				for (size_t index = 0; index < size; index++)
+				{
+					if (data[index] == value)
+					{
+						return index;
+					}
+				}
+
+				return size;
+			}
+		}
+
+		template<typename T>
+		static size_t Count(const T* data, const size_t size, const T& value)
+		{
+			if constexpr (SimdTraits<T>::ENABLED)
+			{
+				return CountIf(data, size, EqualTo<T>(value));
+			}
+			else
+			{
+				size_t count = 0;
+				for (size_t index = 0; index < size; index++)
+				{
+					if (data[index] == value)
+					{
+						count++;
+					}
+				}
+
+				return count;
+			}
+		}
+
+		// size must not be 0
+		template<typename T>
+		static T Min(const T* data, const size_t size)
+		{
+			return Reduce<false>(data, size);
+		}
+
+		// size must not be 0
+		template<typename T>
+		static T Max(const T* data, const size_t size)
+		{
+			return Reduce<true>(data, size);
+		}
+
+	private :
+		template<bool IsMax, typename T>
+		static bool IsBetter(const T& candidate, const T& current)
+		{
+			if constexpr (IsMax)
+			{
+				return current < candidate;
+			}
+			else
+			{
+				return candidate < current;
+			}
+		}
+
+		template<bool IsMax, typename Traits>
+		static typename Traits::VectorType Combine(const typename Traits::VectorType lhs, const typename Traits::VectorType rhs)
+		{
+			if constexpr (IsMax)
+			{
+				return Traits::Max(lhs, rhs);
+			}
+			else
+			{
+				return Traits::Min(lhs, rhs);
+			}
+		}
+
+		// Keep the running extreme per lane, then fold the lanes and the tail with the scalar compare
+		template<bool IsMax, typename T>
+		static T Reduce(const T* data, const size_t size)
+		{
+			size_t index = 0;
+			T result = data[0];
+
+			if constexpr (SimdTraits<T>::ENABLED && SimdTraits<T>::ORDERED)
+			{
+				using Traits = SimdTraits<T>;
+				constexpr size_t LANE_COUNT = Traits::Mask::VECTOR_SIZE / sizeof(T);
+
+				if (size >= UNROLL_COUNT * LANE_COUNT)
+				{
+					// Independent accumulators, so consecutive loads do not wait on each other's min or max
+					typename Traits::VectorType accumulator = Traits::Load(data);
+					typename Traits::VectorType accumulator1 = Traits::Load(data + LANE_COUNT);
+					typename Traits::VectorType accumulator2 = Traits::Load(data + 2 * LANE_COUNT);
+					typename Traits::VectorType accumulator3 = Traits::Load(data + 3 * LANE_COUNT);
+
+					for (index = UNROLL_COUNT * LANE_COUNT; index + UNROLL_COUNT * LANE_COUNT <= size; index += UNROLL_COUNT * LANE_COUNT)
+					{
+						accumulator = Combine<IsMax, Traits>(accumulator, Traits::Load(data + index));
+						accumulator1 = Combine<IsMax, Traits>(accumulator1, Traits::Load(data + index + LANE_COUNT));
+						accumulator2 = Combine<IsMax, Traits>(accumulator2, Traits::Load(data + index + 2 * LANE_COUNT));
+						accumulator3 = Combine<IsMax, Traits>(accumulator3, Traits::Load(data + index + 3 * LANE_COUNT));
+					}
+
+					accumulator = Combine<IsMax, Traits>(Combine<IsMax, Traits>(accumulator, accumulator1), Combine<IsMax, Traits>(accumulator2, accumulator3));
+
+					for (; index + LANE_COUNT <= size; index += LANE_COUNT)
+					{
+						accumulator = Combine<IsMax, Traits>(accumulator, Traits::Load(data + index));
+					}
+
+					T lanes[LANE_COUNT];
+					Traits::Store(lanes, accumulator);
+
+					result = lanes[0];
+					for (size_t lane = 1; lane < LANE_COUNT; lane++)
+					{
+						if (IsBetter<IsMax>(lanes[lane], result))
+						{
+							result = lanes[lane];
+						}
+					}
+				}
+			}
+
+			for (; index < size; index++)
+			{
+				if (IsBetter<IsMax>(data[index], result))
+				{
+					result = data[index];
+				}
+			}
+
+			return result;
+		}
+
+		static size_t CountTrailingZeros(const uint32_t mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long index = 0;
+			_BitScanForward(&index, mask);
+			return static_cast<size_t>(index);
+#else
+			return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+		}
+	};
+};
+
+#endif // __WTR_SIMD_H__
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef __WTR_SMALLARRAY_H__
+#define __WTR_SMALLARRAY_H__
+
+#include <cstddef>
+
+#include "DynamicArray.h"
+#include "InlineArena.h"
+#include "GrowthPolicy.h"
+#include "MemoryResource.h"
+
+namespace wtr
+{
+	// Dynamic array keeping up to N elements in its own storage, and taking memory from the fallback allocator only beyond that.
+	// The first growth reserves exactly N elements from the inline buffer, later growth follows DoubleGrowth.
+	// Moving a small array moves its elements one by one, since the inline buffer can not change owner.
+	// The fallback defaults to the pointer sized ResourceAllocator, so the array stays small enough to embed in hot objects.
+	template<typename T, size_t N, typename Fallback = ResourceAllocator>
+	class SmallArray : public DynamicArray<T, InlineArena<sizeof(T) * N + (alignof(T) > alignof(std::max_align_t) ? alignof(T) : 0), Fallback>, DoubleGrowth<N>>
+	{
+		static_assert(0 != N, "The small array's inline capacity must not be empty");
+
+	public :
+		using Base = DynamicArray<T, InlineArena<sizeof(T) * N + (alignof(T) > alignof(std::max_align_t) ? alignof(T) : 0), Fallback>, DoubleGrowth<N>>;
+
+		static constexpr size_t INLINE_CAPACITY = N;
+
+		using Base::Base;
+
+		SmallArray() = default;
+		SmallArray(const SmallArray& other) = default;
+		SmallArray(SmallArray&& other) = default;
+
+		~SmallArray() = default;
+
+		SmallArray& operator=(const SmallArray& other) = default;
+		SmallArray& operator=(SmallArray&& other) = default;
+
+	public :
+		bool IsInline() const
+		{
+			return this->GetAllocator().Owns(this->Data());
+		}
+	};
+};
+
+#endif // __WTR_SMALLARRAY_H__
\ No newline at end of file
@@ -0,0 +1,949 @@
+#ifndef __WTR_SORT_H__
+#define __WTR_SORT_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace wtr
+{
+	// Maps a sort key to an unsigned integer with the same order, which RadixSort takes apart byte by byte.
+	// Signed integers flip the sign bit, floating points flip every bit when negative and only the sign bit otherwise.
+	template<typename Key, typename = void>
+	struct RadixKey;
+
+	template<typename Key>
+	struct RadixKey<Key, std::enable_if_t<std::is_integral_v<Key> && !std::is_same_v<Key, bool>>>
+	{
+		using Type = std::make_unsigned_t<Key>;
+
+		static Type Get(const Key key)
+		{
+			if constexpr (std::is_signed_v<Key>)
+			{
+				return static_cast<Type>(key) ^ (Type(1) << (sizeof(Type) * 8 - 1));
+			}
+			else
+			{
+				return key;
+			}
+		}
+	};
+
+	template<typename Key>
+	struct RadixKey<Key, std::enable_if_t<std::is_enum_v<Key>>>
+	{
+		using UnderlyingType = std::underlying_type_t<Key>;
+		using Type = typename RadixKey<UnderlyingType>::Type;
+
+		static Type Get(const Key key)
+		{
+			return RadixKey<UnderlyingType>::Get(static_cast<UnderlyingType>(key));
+		}
+	};
+
+	template<typename Key>
+	struct RadixKey<Key, std::enable_if_t<std::is_floating_point_v<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)>>
+	{
+		using Type = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+
+		static Type Get(const Key key)
+		{
+			Type bits;
+			std::memcpy(&bits, &key, sizeof(Type));
+
+			const Type signBit = Type(1) << (sizeof(Type) * 8 - 1);
+
+			return bits ^ ((0 != (bits & signBit)) ? ~Type(0) : signBit);
+		}
+	};
+
+	// Key function of RadixSort for arrays of the keys themselves
+	struct IdentityKey
+	{
+		template<typename T>
+		const T& operator()(const T& value) const
+		{
+			return value;
+		}
+	};
+
+	// Sorting kernels over contiguous ranges, the comparator is a template so every compare inlines.
+	// Sort is a pattern-defeating quicksort, which is O(n log n) in the worst case through a heapsort fallback,
+	// and linear on sorted, reversed and other patterned input.
+	// StableSort is a bottom-up merge sort keeping the order of equal elements, and it needs a buffer for half the range.
+	// RadixSort is a stable LSD radix sort on an integer, enum or floating point key, linear in the range size.
+	// ParallelSort sorts one chunk per thread and merges them in parallel, it needs a buffer for the whole range
+	// and is not stable, since the chunks are sorted with Sort.
+	class SortAlgorithm
+	{
+	public :
+		static constexpr size_t INSERTION_SORT_THRESHOLD = 24;
+		static constexpr size_t NINTHER_THRESHOLD = 128;
+		static constexpr size_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+		static constexpr size_t STABLE_RUN_SIZE = 32;
+		static constexpr size_t PARALLEL_CHUNK_SIZE = 16 * 1024;
+		static constexpr size_t RADIX_SORT_THRESHOLD = 64;
+
+		template<typename T, typename Compare>
+		static void Sort(T* first, T* last, Compare compare)
+		{
+			const size_t size = static_cast<size_t>(last - first);
+			if (size < 2)
+			{
+				return;
+			}
+
+			SortLoop(first, last, compare, GetLog2(size), true);
+		}
+
+		// buffer must be raw memory for GetStableBufferSize(last - first) elements, or nullptr to merge in place
+		// with rotations, which is still stable but O(n log^2 n)
+		template<typename T, typename Compare>
+		static void StableSort(T* first, T* last, Compare compare, T* buffer)
+		{
+			const size_t size = static_cast<size_t>(last - first);
+			if (size < 2)
+			{
+				return;
+			}
+
+			for (size_t lower = 0; lower < size; lower += STABLE_RUN_SIZE)
+			{
+				const size_t upper = (lower + STABLE_RUN_SIZE < size) ? lower + STABLE_RUN_SIZE : size;
+
+				InsertionSort(first + lower, first + upper, compare);
+			}
+
+			for (size_t width = STABLE_RUN_SIZE; width < size; width *= 2)
+			{
+				for (size_t lower = 0; lower + width < size; lower += 2 * width)
+				{
+					const size_t upper = (lower + 2 * width < size) ? lower + 2 * width : size;
+
+					if (nullptr != buffer)
+					{
+						Merge(first + lower, first + lower + width, first + upper, compare, buffer);
+					}
+					else
+					{
+						MergeInPlace(first + lower, first + lower + width, first + upper, compare);
+					}
+				}
+			}
+		}
+
+		static constexpr size_t GetStableBufferSize(const size_t size)
+		{
+			return size / 2;
+		}
+
+		// Merge the sorted ranges [first, middle) and [middle, last) in place, the smaller one is moved through the buffer
+		template<typename T, typename Compare>
+		static void Merge(T* first, T* middle, T* last, Compare compare, T* buffer)
+		{
+			if (first == middle || middle == last || !compare(*middle, *(middle - 1)))
+			{
+				return;
+			}
+
+			const size_t leftSize = static_cast<size_t>(middle - first);
+			const size_t rightSize = static_cast<size_t>(last - middle);
+
+			if (leftSize <= rightSize)
+			{
+				MoveConstruct(buffer, first, leftSize);
+
+				T* left = buffer;
+				T* leftEnd = buffer + leftSize;
+				T* right = middle;
+				T* out = first;
+
+				while (left != leftEnd && right != last)
+				{
+					// Take from the right only when strictly smaller, so equal elements keep their order
+					if (compare(*right, *left))
+					{
+						*out++ = std::move(*right++);
+					}
+					else
+					{
+						*out++ = std::move(*left++);
+					}
+				}
+
+				while (left != leftEnd)
+				{
+					*out++ = std::move(*left++);
+				}
+
+				Destroy(buffer, leftSize);
+			}
+			else
+			{
+				MoveConstruct(buffer, middle, rightSize);
+
+				size_t leftCount = leftSize;
+				size_t rightCount = rightSize;
+				T* out = last;
+
+				while (0 != leftCount && 0 != rightCount)
+				{
+					if (compare(buffer[rightCount - 1], first[leftCount - 1]))
+					{
+						*--out = std::move(first[--leftCount]);
+					}
+					else
+					{
+						*--out = std::move(buffer[--rightCount]);
+					}
+				}
+
+				while (0 != rightCount)
+				{
+					*--out = std::move(buffer[--rightCount]);
+				}
+
+				Destroy(buffer, rightSize);
+			}
+		}
+
+		// Merge the sorted ranges [first, middle) and [middle, last) without a buffer.
+		// The longer range is cut in half, the other at the matching bound, and the two middle parts swap places by a rotation.
+		template<typename T, typename Compare>
+		static void MergeInPlace(T* first, T* middle, T* last, Compare& compare)
+		{
+			while (first != middle && middle != last && compare(*middle, *(middle - 1)))
+			{
+				const size_t leftSize = static_cast<size_t>(middle - first);
+				const size_t rightSize = static_cast<size_t>(last - middle);
+
+				if (1 == leftSize && 1 == rightSize)
+				{
+					std::iter_swap(first, middle);
+					return;
+				}
+
+				T* leftCut = nullptr;
+				T* rightCut = nullptr;
+				if (leftSize > rightSize)
+				{
+					leftCut = first + leftSize / 2;
+					rightCut = std::lower_bound(middle, last, *leftCut, compare);
+				}
+				else
+				{
+					rightCut = middle + rightSize / 2;
+					leftCut = std::upper_bound(first, middle, *rightCut, compare);
+				}
+
+				T* newMiddle = std::rotate(leftCut, middle, rightCut);
+
+				MergeInPlace(first, leftCut, newMiddle, compare);
+
+				first = newMiddle;
+				middle = rightCut;
+			}
+		}
+
+		// Orders two elements by their radix key, the order RadixSort puts them in, so a comparison sort can stand in for it
+		template<typename T, typename KeyFunc>
+		static auto GetRadixCompare(KeyFunc& keyFunc)
+		{
+			using KeyType = std::decay_t<decltype(keyFunc(std::declval<const T&>()))>;
+
+			return [&keyFunc](const T& lhs, const T& rhs)
+			{
+				return RadixKey<KeyType>::Get(keyFunc(lhs)) < RadixKey<KeyType>::Get(keyFunc(rhs));
+			};
+		}
+
+		static constexpr size_t GetRadixBufferSize(const size_t size)
+		{
+			return size;
+		}
+
+		// One scan counts every byte of every key, then each byte from the lowest scatters the range to the other side.
+		// A byte which is the same in all keys leaves the order as it is, so its pass is skipped.
+		// buffer must be raw memory for GetRadixBufferSize(last - first) elements
+		template<typename T, typename KeyFunc>
+		static void RadixSort(T* first, T* last, KeyFunc keyFunc, T* buffer)
+		{
+			using KeyType = std::decay_t<decltype(keyFunc(*first))>;
+			using RadixType = typename RadixKey<KeyType>::Type;
+
+			constexpr size_t PASS_COUNT = sizeof(RadixType);
+			constexpr size_t BUCKET_COUNT = 256;
+
+			const size_t size = static_cast<size_t>(last - first);
+			if (size <= RADIX_SORT_THRESHOLD)
+			{
+				InsertionSort(first, last, GetRadixCompare<T>(keyFunc));
+				return;
+			}
+
+			size_t counts[PASS_COUNT][BUCKET_COUNT] = {};
+			for (size_t index = 0; index < size; index++)
+			{
+				const RadixType key = RadixKey<KeyType>::Get(keyFunc(first[index]));
+
+				for (size_t pass = 0; pass < PASS_COUNT; pass++)
+				{
+					counts[pass][GetRadixDigit(key, pass)]++;
+				}
+			}
+
+			T* source = first;
+			T* destination = buffer;
+			bool bufferConstructed = false;
+
+			for (size_t pass = 0; pass < PASS_COUNT; pass++)
+			{
+				const size_t* passCounts = counts[pass];
+				if (size == passCounts[GetRadixDigit(RadixKey<KeyType>::Get(keyFunc(*source)), pass)])
+				{
+					continue;
+				}
+
+				size_t offsets[BUCKET_COUNT];
+				size_t offset = 0;
+				for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+				{
+					offsets[bucket] = offset;
+					offset += passCounts[bucket];
+				}
+
+				// The first scatter always fills the raw buffer, later ones assign over moved from elements
+				for (size_t index = 0; index < size; index++)
+				{
+					T* target = destination + offsets[GetRadixDigit(RadixKey<KeyType>::Get(keyFunc(source[index])), pass)]++;
+
+					if (bufferConstructed)
+					{
+						*target = std::move(source[index]);
+					}
+					else
+					{
+						new (target) T(std::move(source[index]));
+					}
+				}
+
+				bufferConstructed = true;
+
+				T* swap = source;
+				source = destination;
+				destination = swap;
+			}
+
+			if (source != first)
+			{
+				MoveAssign(first, source, size);
+			}
+
+			if (bufferConstructed)
+			{
+				Destroy(buffer, size);
+			}
+		}
+
+		// Number of threads ParallelSort really uses, 0 asks for every hardware thread.
+		// Each thread gets at least PARALLEL_CHUNK_SIZE elements, so 1 means the range is better sorted sequentially.
+		static size_t GetParallelThreadCount(const size_t size, const size_t threadCount)
+		{
+			size_t count = (0 == threadCount) ? static_cast<size_t>(std::thread::hardware_concurrency()) : threadCount;
+			if (count > size / PARALLEL_CHUNK_SIZE)
+			{
+				count = size / PARALLEL_CHUNK_SIZE;
+			}
+
+			return (0 == count) ? 1 : count;
+		}
+
+		static constexpr size_t GetParallelBufferSize(const size_t size)
+		{
+			return size;
+		}
+
+		// Each thread sorts one chunk, then the sorted runs are merged pairwise between the range and the buffer.
+		// Every merge is split into equal output parts by a binary search, so all threads stay busy down to the last merge.
+		// The threads are started once and meet at a barrier between phases.
+		// The chunks are sorted with Sort, so like Sort it does not keep the order of equal elements.
+		// buffer must be raw memory for GetParallelBufferSize(last - first) elements
+		template<typename T, typename Compare>
+		static void ParallelSort(T* first, T* last, Compare compare, T* buffer, const size_t threadCount = 0)
+		{
+			const size_t size = static_cast<size_t>(last - first);
+			const size_t chunkCount = GetParallelThreadCount(size, threadCount);
+			if (1 == chunkCount)
+			{
+				Sort(first, last, compare);
+				return;
+			}
+
+			std::unique_ptr<size_t[]> ranks(new size_t[chunkCount]);
+			Barrier barrier(chunkCount);
+
+			// Start of run index when every run spans step chunks, the range's size past the last run
+			auto getBound = [size, chunkCount](const size_t run, const size_t step)
+			{
+				const size_t chunk = run * step;
+
+				return (chunk < chunkCount) ? size * chunk / chunkCount : size;
+			};
+
+			RunParallel(chunkCount, [&](const size_t worker)
+			{
+				{
+					T* lower = first + getBound(worker, 1);
+					T* upper = first + getBound(worker + 1, 1);
+
+					Sort(lower, upper, compare);
+					MoveConstruct(buffer + getBound(worker, 1), lower, static_cast<size_t>(upper - lower));
+				}
+
+				barrier.Wait();
+
+				// The sorted runs now live in the buffer, and the range is left with moved from elements to assign over
+				T* source = buffer;
+				T* destination = first;
+
+				size_t runCount = chunkCount;
+				size_t step = 1;
+				while (1 < runCount)
+				{
+					const size_t pairCount = runCount / 2;
+					const size_t partCount = (chunkCount > pairCount) ? chunkCount / pairCount : 1;
+					const size_t taskCount = pairCount * partCount + (runCount & 1);
+
+					// Split every merge before any element moves, since the split search reads the runs that the merges empty
+					for (size_t task = worker; task < pairCount * partCount; task += chunkCount)
+					{
+						const size_t pair = task / partCount;
+						const size_t part = task % partCount;
+
+						const size_t lower = getBound(2 * pair, step);
+						const size_t middle = getBound(2 * pair + 1, step);
+						const size_t upper = getBound(2 * pair + 2, step);
+
+						ranks[task] = GetMergeRank(source + lower, middle - lower, source + middle, upper - middle, (upper - lower) * part / partCount, compare);
+					}
+
+					barrier.Wait();
+
+					for (size_t task = worker; task < taskCount; task += chunkCount)
+					{
+						if (task == pairCount * partCount)
+						{
+							// The odd run out has no partner this round
+							const size_t lower = getBound(runCount - 1, step);
+							MoveAssign(destination + lower, source + lower, size - lower);
+							continue;
+						}
+
+						const size_t pair = task / partCount;
+						const size_t part = task % partCount;
+
+						const size_t lower = getBound(2 * pair, step);
+						const size_t middle = getBound(2 * pair + 1, step);
+						const size_t upper = getBound(2 * pair + 2, step);
+
+						const size_t outputBegin = (upper - lower) * part / partCount;
+						const size_t outputEnd = (upper - lower) * (part + 1) / partCount;
+
+						const size_t aBegin = ranks[task];
+						const size_t aEnd = (part + 1 < partCount) ? ranks[task + 1] : middle - lower;
+
+						MergePart(source + lower + aBegin, source + lower + aEnd, source + middle + (outputBegin - aBegin), source + middle + (outputEnd - aEnd),
+							destination + lower + outputBegin, compare);
+					}
+
+					barrier.Wait();
+
+					runCount = (runCount + 1) / 2;
+					step *= 2;
+
+					T* swap = source;
+					source = destination;
+					destination = swap;
+				}
+
+				const size_t lower = getBound(worker, 1);
+				const size_t upper = getBound(worker + 1, 1);
+
+				if (source != first)
+				{
+					MoveAssign(first + lower, source + lower, upper - lower);
+				}
+
+				Destroy(buffer + lower, upper - lower);
+			});
+		}
+
+		template<typename T, typename Compare>
+		static void InsertionSort(T* first, T* last, Compare compare)
+		{
+			if (first == last)
+			{
+				return;
+			}
+
+			for (T* current = first + 1; current != last; current++)
+			{
+				if (compare(*current, *(current - 1)))
+				{
+					T value = std::move(*current);
+
+					T* sift = current;
+					do
+					{
+						*sift = std::move(*(sift - 1));
+						sift--;
+					} while (sift != first && compare(value, *(sift - 1)));
+
+					*sift = std::move(value);
+				}
+			}
+		}
+
+	private :
+		static size_t GetLog2(size_t size)
+		{
+			size_t log = 0;
+			while (size >>= 1)
+			{
+				log++;
+			}
+
+			return log;
+		}
+
+		template<typename T>
+		static void MoveConstruct(T* destination, T* source, const size_t count)
+		{
+			for (size_t index = 0; index < count; index++)
+			{
+				new (destination + index) T(std::move(source[index]));
+			}
+		}
+
+		template<typename RadixType>
+		static size_t GetRadixDigit(const RadixType key, const size_t pass)
+		{
+			return static_cast<size_t>((key >> (pass * 8)) & 0xFF);
+		}
+
+		template<typename T>
+		static void MoveAssign(T* destination, T* source, const size_t count)
+		{
+			for (size_t index = 0; index < count; index++)
+			{
+				destination[index] = std::move(source[index]);
+			}
+		}
+
+		template<typename T>
+		static void Destroy(T* data, const size_t count)
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (size_t index = 0; index < count; index++)
+				{
+					data[index].~T();
+				}
+			}
+		}
+
+		// Blocks every caller of Wait until count threads have arrived, and can be reused right away for the next phase
+		class Barrier
+		{
+		public :
+			explicit Barrier(const size_t count)
+				: m_mutex()
+				, m_condition()
+				, m_count(count)
+				, m_waitCount(0)
+				, m_generation(0)
+			{}
+
+			void Wait()
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+
+				const size_t generation = m_generation;
+				if (++m_waitCount == m_count)
+				{
+					m_waitCount = 0;
+					m_generation++;
+					m_condition.notify_all();
+					return;
+				}
+
+				m_condition.wait(lock, [this, generation]() { return generation != m_generation; });
+			}
+
+		private :
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+			const size_t m_count;
+			size_t m_waitCount;
+			size_t m_generation;
+		};
+
+		// Run func(0) to func(count - 1), the calling thread takes index 0
+		template<typename Func>
+		static void RunParallel(const size_t count, const Func& func)
+		{
+			std::unique_ptr<std::thread[]> threads(new std::thread[count]);
+			for (size_t index = 1; index < count; index++)
+			{
+				threads[index] = std::thread([&func, index]() { func(index); });
+			}
+
+			func(0);
+
+			for (size_t index = 1; index < count; index++)
+			{
+				threads[index].join();
+			}
+		}
+
+		// Number of elements of a among the first outputIndex outputs of the stable merge of a and b
+		template<typename T, typename Compare>
+		static size_t GetMergeRank(const T* a, const size_t aSize, const T* b, const size_t bSize, const size_t outputIndex, Compare& compare)
+		{
+			size_t lower = (outputIndex > bSize) ? outputIndex - bSize : 0;
+			size_t upper = (outputIndex < aSize) ? outputIndex : aSize;
+
+			while (lower < upper)
+			{
+				const size_t aIndex = (lower + upper) / 2;
+				const size_t bIndex = outputIndex - aIndex;
+
+				// a[aIndex] goes before b[bIndex - 1] on ties, so aIndex is too small
+				if (0 != bIndex && !compare(b[bIndex - 1], a[aIndex]))
+				{
+					lower = aIndex + 1;
+				}
+				else
+				{
+					upper = aIndex;
+				}
+			}
+
+			return lower;
+		}
+
+		// Stable merge of [left, leftEnd) and [right, rightEnd), move assigned to out
+		template<typename T, typename Compare>
+		static void MergePart(T* left, T* leftEnd, T* right, T* rightEnd, T* out, Compare& compare)
+		{
+			while (left != leftEnd && right != rightEnd)
+			{
+				if (compare(*right, *left))
+				{
+					*out++ = std::move(*right++);
+				}
+				else
+				{
+					*out++ = std::move(*left++);
+				}
+			}
+
+			while (left != leftEnd)
+			{
+				*out++ = std::move(*left++);
+			}
+
+			while (right != rightEnd)
+			{
+				*out++ = std::move(*right++);
+			}
+		}
+
+		template<typename T, typename Compare>
+		static void Sort2(T* a, T* b, Compare& compare)
+		{
+			if (compare(*b, *a))
+			{
+				std::iter_swap(a, b);
+			}
+		}
+
+		template<typename T, typename Compare>
+		static void Sort3(T* a, T* b, T* c, Compare& compare)
+		{
+			Sort2(a, b, compare);
+			Sort2(b, c, compare);
+			Sort2(a, b, compare);
+		}
+
+		// Insertion sort for a range which has an element no greater than any of its own right before it
+		template<typename T, typename Compare>
+		static void UnguardedInsertionSort(T* first, T* last, Compare& compare)
+		{
+			for (T* current = first + 1; current < last; current++)
+			{
+				if (compare(*current, *(current - 1)))
+				{
+					T value = std::move(*current);
+
+					T* sift = current;
+					do
+					{
+						*sift = std::move(*(sift - 1));
+						sift--;
+					} while (compare(value, *(sift - 1)));
+
+					*sift = std::move(value);
+				}
+			}
+		}
+
+		// Gives up once more than PARTIAL_INSERTION_SORT_LIMIT elements were moved, the range is then left unsorted
+		template<typename T, typename Compare>
+		static bool PartialInsertionSort(T* first, T* last, Compare& compare)
+		{
+			if (first == last)
+			{
+				return true;
+			}
+
+			size_t moveCount = 0;
+			for (T* current = first + 1; current != last; current++)
+			{
+				if (compare(*current, *(current - 1)))
+				{
+					T value = std::move(*current);
+
+					T* sift = current;
+					do
+					{
+						*sift = std::move(*(sift - 1));
+						sift--;
+					} while (sift != first && compare(value, *(sift - 1)));
+
+					*sift = std::move(value);
+
+					moveCount += static_cast<size_t>(current - sift);
+				}
+
+				if (moveCount > PARTIAL_INSERTION_SORT_LIMIT)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// Partition around *first, elements equal to the pivot go right.
+		// Also reports whether the range was already partitioned, when no element had to be swapped.
+		template<typename T, typename Compare>
+		static std::pair<T*, bool> PartitionRight(T* first, T* last, Compare& compare)
+		{
+			T pivot = std::move(*first);
+
+			T* left = first;
+			T* right = last;
+
+			while (compare(*++left, pivot));
+
+			if (left - 1 == first)
+			{
+				while (left < right && !compare(*--right, pivot));
+			}
+			else
+			{
+				while (!compare(*--right, pivot));
+			}
+
+			const bool alreadyPartitioned = left >= right;
+
+			while (left < right)
+			{
+				std::iter_swap(left, right);
+
+				while (compare(*++left, pivot));
+				while (!compare(*--right, pivot));
+			}
+
+			T* pivotPos = left - 1;
+			*first = std::move(*pivotPos);
+			*pivotPos = std::move(pivot);
+
+			return std::make_pair(pivotPos, alreadyPartitioned);
+		}
+
+		// Partition around *first, elements equal to the pivot go left.
+		// Used when the pivot equals the element before the range, so every equal element is already in place.
+		template<typename T, typename Compare>
+		static T* PartitionLeft(T* first, T* last, Compare& compare)
+		{
+			T pivot = std::move(*first);
+
+			T* left = first;
+			T* right = last;
+
+			while (compare(pivot, *--right));
+
+			if (right + 1 == last)
+			{
+				while (left < right && !compare(pivot, *++left));
+			}
+			else
+			{
+				while (!compare(pivot, *++left));
+			}
+
+			while (left < right)
+			{
+				std::iter_swap(left, right);
+
+				while (compare(pivot, *--right));
+				while (!compare(pivot, *++left));
+			}
+
+			T* pivotPos = right;
+			*first = std::move(*pivotPos);
+			*pivotPos = std::move(pivot);
+
+			return pivotPos;
+		}
+
+		template<typename T, typename Compare>
+		static void SortLoop(T* first, T* last, Compare& compare, size_t badAllowed, bool leftmost)
+		{
+			while (true)
+			{
+				const size_t size = static_cast<size_t>(last - first);
+
+				if (size < INSERTION_SORT_THRESHOLD)
+				{
+					if (leftmost)
+					{
+						InsertionSort(first, last, compare);
+					}
+					else
+					{
+						UnguardedInsertionSort(first, last, compare);
+					}
+
+					return;
+				}
+
+				// Median of three, or the pseudo median of nine for large ranges, is moved to the front as the pivot
+				const size_t half = size / 2;
+				if (size > NINTHER_THRESHOLD)
+				{
+					Sort3(first, first + half, last - 1, compare);
+					Sort3(first + 1, first + (half - 1), last - 2, compare);
+					Sort3(first + 2, first + (half + 1), last - 3, compare);
+					Sort3(first + (half - 1), first + half, first + (half + 1), compare);
+					std::iter_swap(first, first + half);
+				}
+				else
+				{
+					Sort3(first + half, first, last - 1, compare);
+				}
+
+				if (!leftmost && !compare(*(first - 1), *first))
+				{
+					first = PartitionLeft(first, last, compare) + 1;
+					continue;
+				}
+
+				const std::pair<T*, bool> partition = PartitionRight(first, last, compare);
+				T* pivotPos = partition.first;
+
+				const size_t leftSize = static_cast<size_t>(pivotPos - first);
+				const size_t rightSize = static_cast<size_t>(last - (pivotPos + 1));
+
+				if (leftSize < size / 8 || rightSize < size / 8)
+				{
+					// Too many bad partitions means an adversarial pattern, so finish with the guaranteed heapsort
+					if (0 == --badAllowed)
+					{
+						std::make_heap(first, last, compare);
+						std::sort_heap(first, last, compare);
+						return;
+					}
+
+					// Break the pattern by swapping a few elements on both sides
+					if (leftSize >= INSERTION_SORT_THRESHOLD)
+					{
+						std::iter_swap(first, first + leftSize / 4);
+						std::iter_swap(pivotPos - 1, pivotPos - leftSize / 4);
+
+						if (leftSize > NINTHER_THRESHOLD)
+						{
+							std::iter_swap(first + 1, first + (leftSize / 4 + 1));
+							std::iter_swap(first + 2, first + (leftSize / 4 + 2));
+							std::iter_swap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+							std::iter_swap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+						}
+					}
+
+					if (rightSize >= INSERTION_SORT_THRESHOLD)
+					{
+						std::iter_swap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+						std::iter_swap(last - 1, last - rightSize / 4);
+
+						if (rightSize > NINTHER_THRESHOLD)
+						{
+							std::iter_swap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+							std::iter_swap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+							std::iter_swap(last - 2, last - (1 + rightSize / 4));
+							std::iter_swap(last - 3, last - (2 + rightSize / 4));
+						}
+					}
+				}
+				else if (partition.second && PartialInsertionSort(first, pivotPos, compare) && PartialInsertionSort(pivotPos + 1, last, compare))
+				{
+					// An already partitioned range is likely sorted, which the partial insertion sorts just confirmed
+					return;
+				}
+
+				// Recurse into the left side and loop on the right, the left side keeps the leftmost flag
+				SortLoop(first, pivotPos, compare, badAllowed, leftmost);
+
+				first = pivotPos + 1;
+				leftmost = false;
+			}
+		}
+	};
+
+	template<typename T, typename Compare = std::less<T>>
+	void Sort(T* first, T* last, Compare compare = Compare())
+	{
+		SortAlgorithm::Sort(first, last, compare);
+	}
+
+	template<typename T, typename Compare = std::less<T>>
+	void StableSort(T* first, T* last, T* buffer, Compare compare = Compare())
+	{
+		SortAlgorithm::StableSort(first, last, compare, buffer);
+	}
+
+	template<typename T, typename KeyFunc = IdentityKey>
+	void RadixSort(T* first, T* last, T* buffer, KeyFunc keyFunc = KeyFunc())
+	{
+		SortAlgorithm::RadixSort(first, last, keyFunc, buffer);
+	}
+
+	template<typename T, typename Compare = std::less<T>>
+	void ParallelSort(T* first, T* last, T* buffer, Compare compare = Compare(), const size_t threadCount = 0)
+	{
+		SortAlgorithm::ParallelSort(first, last, compare, buffer, threadCount);
+	}
+};
+
+#endif // __WTR_SORT_H__
\ No newline at end of file
@@ -7,12 +7,14 @@
 #include <type_traits>
 #include <utility>
 
+#include "Simd.h"
+
 namespace wtr
 {
-	template<typename T, size_t Count>
+	template<typename T, size_t N>
 	class StaticArray
 	{
-		static_assert(Count > 0, "The static array's size must be greater than 0");
+		static_assert(N > 0, "The static array's size must be greater than 0");
 
 	public :
 		template<bool Const, bool Reverse>
@@ -134,7 +136,7 @@ namespace wtr
 		StaticArray() = default;
 		StaticArray(const std::initializer_list<T>& initList)
 		{
-			assert(initList.size() <= Count && "The initializer list is over than max count");
+			assert(initList.size() <= N && "The initializer list is over than max count");
 
 			size_t index = 0;
 			for (auto& element : initList)
@@ -143,7 +145,7 @@ namespace wtr
 				index++;
 			}
 
-			for (; index < Count; index++)
+			for (; index < N; index++)
 			{
 				m_data[index] = T{};
 			}
@@ -152,7 +154,7 @@ namespace wtr
 
 		StaticArray(const StaticArray& other)
 		{
-			for (size_t index = 0; index < Count; index++)
+			for (size_t index = 0; index < N; index++)
 			{
 				m_data[index] = other[index];
 			}
@@ -160,7 +162,7 @@ namespace wtr
 
 		StaticArray(StaticArray&& other) noexcept
 		{
-			for (size_t index = 0; index < Count; index++)
+			for (size_t index = 0; index < N; index++)
 			{
 				m_data[index] = std::move(other[index]);
 			}
@@ -172,7 +174,7 @@ namespace wtr
 		{
 			if (this != &other)
 			{
-				for (size_t index = 0; index < Count; index++)
+				for (size_t index = 0; index < N; index++)
 				{
 					m_data[index] = other[index];
 				}
@@ -183,7 +185,7 @@ namespace wtr
 
 		StaticArray& operator=(StaticArray&& other) noexcept
 		{
-			for (size_t index = 0; index < Count; index++)
+			for (size_t index = 0; index < N; index++)
 			{
 				m_data[index] = std::move(other[index]);
 			}
@@ -193,7 +195,7 @@ namespace wtr
 
 		bool operator==(const StaticArray& other) const
 		{
-			for (size_t index = 0; index < Count; index++)
+			for (size_t index = 0; index < N; index++)
 			{
 				if (m_data[index] != other.m_data[index])
 				{
@@ -211,14 +213,14 @@ namespace wtr
 
 		T& operator[](const size_t index)
 		{
-			assert(index < Count && "Index out of bounds");
+			assert(index < N && "Index out of bounds");
 
 			return m_data[index];
 		}
 
 		const T& operator[](const size_t index) const
 		{
-			assert(index < Count && "Index out of bounds");
+			assert(index < N && "Index out of bounds");
 
 			return m_data[index];
 		}
@@ -231,9 +233,9 @@ namespace wtr
 
 		T& Back()
 		{
-			assert(0 < Count && "The array is empty, failed to get the end data");
+			assert(0 < N && "The array is empty, failed to get the end data");
 
-			return m_data[Count - 1];
+			return m_data[N - 1];
 		}
 
 		const T& Front() const
@@ -243,22 +245,22 @@ namespace wtr
 
 		const T& Back() const
 		{
-			assert(0 < Count && "The array is empty, failed to get the end data");
+			assert(0 < N && "The array is empty, failed to get the end data");
 
-			return m_data[Count - 1];
+			return m_data[N - 1];
 		}
 
 	public :
 		T& At(const size_t index)
 		{
-			assert(index < Count && "The index is over than array's max count");
+			assert(index < N && "The index is over than array's max count");
 
 			return m_data[index];
 		}
 
 		const T& At(const size_t index) const
 		{
-			assert(index < Count && "The index is over than array's max count");
+			assert(index < N && "The index is over than array's max count");
 
 			return m_data[index];
 		}
@@ -275,43 +277,94 @@ namespace wtr
 
 		constexpr size_t Size() const
 		{
-			return Count;
+			return N;
 		}
 
 		template<typename... Args>
 		void Fill(Args&&... args)
 		{
-			for (size_t index = 0; index < Count; index++)
+			for (size_t index = 0; index < N; index++)
 			{
 				m_data[index] = T(std::forward<Args>(args)...);
 			}
 		}
 
+		Iterator Find(const T& other)
+		{
+			return Iterator(*this, SimdAlgorithm::Find(m_data, N, other));
+		}
+
+		ConstIterator Find(const T& other) const
+		{
+			return ConstIterator(*this, SimdAlgorithm::Find(m_data, N, other));
+		}
+
+		template<typename Predicate>
+		Iterator FindIf(const Predicate& predicate)
+		{
+			return Iterator(*this, SimdAlgorithm::FindIf(m_data, N, predicate));
+		}
+
+		// Predicates like LessThan or InRange are vectorized for arithmetic elements, any other callable is tested one by one
+		template<typename Predicate>
+		ConstIterator FindIf(const Predicate& predicate) const
+		{
+			return ConstIterator(*this, SimdAlgorithm::FindIf(m_data, N, predicate));
+		}
+
+		bool Contains(const T& other) const
+		{
+			return N != SimdAlgorithm::Find(m_data, N, other);
+		}
+
+		size_t Count(const T& other) const
+		{
+			return SimdAlgorithm::Count(m_data, N, other);
+		}
+
+		template<typename Predicate>
+		size_t CountIf(const Predicate& predicate) const
+		{
+			return SimdAlgorithm::CountIf(m_data, N, predicate);
+		}
+
+		// Arrays holding NaN have no defined minimum or maximum; the result may or may not be a NaN
+		// depending on where it sits and whether the SIMD kernel ran, so filter NaN out first
+		T Min() const
+		{
+			return SimdAlgorithm::Min(m_data, N);
+		}
+
+		T Max() const
+		{
+			return SimdAlgorithm::Max(m_data, N);
+		}
+
 	public :
 		// Standard Range Iterator
 		Iterator begin() { return Iterator(*this, 0); }
-		Iterator end() { return Iterator(*this, Count);	}
+		Iterator end() { return Iterator(*this, N);	}
 		ConstIterator begin() const { return ConstIterator(*this, 0); }
-		ConstIterator end() const {	return ConstIterator(*this, Count);	}
+		ConstIterator end() const {	return ConstIterator(*this, N);	}
 
-		ReverseIterator rbegin() { return ReverseIterator(*this, Count); }
+		ReverseIterator rbegin() { return ReverseIterator(*this, N); }
 		ReverseIterator rend() { return ReverseIterator(*this, 0); }
-		ConstReverseIterator rbegin() const { return ConstReverseIterator(*this, Count); }
+		ConstReverseIterator rbegin() const { return ConstReverseIterator(*this, N); }
 		ConstReverseIterator rend() const { return ConstReverseIterator(*this, 0); }
 
 	public :
 		Iterator Begin() { return Iterator(*this, 0); }
-		Iterator End() { return Iterator(*this, Count); }
+		Iterator End() { return Iterator(*this, N); }
 		ConstIterator Begin() const { return ConstIterator(*this, 0); }
-		ConstIterator End() const { return ConstIterator(*this, Count);	}
+		ConstIterator End() const { return ConstIterator(*this, N);	}
 
-		ReverseIterator rBegin() { return ReverseIterator(*this, Count); }
+		ReverseIterator rBegin() { return ReverseIterator(*this, N); }
 		ReverseIterator rEnd() { return ReverseIterator(*this, 0); }
-		ConstReverseIterator rBegin() const { return ConstReverseIterator(*this, Count); }
+		ConstReverseIterator rBegin() const { return ConstReverseIterator(*this, N); }
 		ConstReverseIterator rEnd() const { return ConstReverseIterator(*this, 0); }
 
 	private :
-		T m_data[Count];
+		T m_data[N];
 	};
 };
 
@@ -3,9 +3,71 @@
 
 #include <cstddef>
 #include <new>
+#include <type_traits>
+#include <utility>
 
 namespace wtr
 {
+	// Detect the optional allocator functions, so containers can use them when the allocator provides them
+	template<typename Allocator, typename = void>
+	struct HasDeallocate : std::false_type {};
+
+	template<typename Allocator>
+	struct HasDeallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().Deallocate(std::declval<void*>()))>> : std::true_type {};
+
+	template<typename Allocator, typename = void>
+	struct HasExtend : std::false_type {};
+
+	template<typename Allocator>
+	struct HasExtend<Allocator, std::void_t<decltype(std::declval<Allocator&>().Extend(std::declval<void*>(), std::declval<size_t>()))>> : std::true_type {};
+
+	template<typename Allocator, typename = void>
+	struct HasReallocate : std::false_type {};
+
+	template<typename Allocator>
+	struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().Reallocate(std::declval<void*>(), std::declval<size_t>(), std::declval<size_t>()))>> : std::true_type {};
+
+	template<typename Allocator, typename = void>
+	struct IsEqualityComparable : std::false_type {};
+
+	template<typename Allocator>
+	struct IsEqualityComparable<Allocator, std::void_t<decltype(std::declval<const Allocator&>() == std::declval<const Allocator&>())>> : std::true_type {};
+
+	// Types whose objects can be moved to a new address with memcpy, leaving the source without a destructor call.
+	// Trivially copyable types are relocatable, and a type owning its buffer through a plain pointer can opt in with
+	// template<> struct IsTriviallyRelocatable<MyType> : std::true_type {};
+	template<typename T>
+	struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+	// A copied container shares a copyable allocator, like a reference to a shared arena,
+	// and gets a fresh instance of an allocator which owns its memory
+	template<typename Allocator>
+	Allocator SelectAllocator(const Allocator& allocator)
+	{
+		if constexpr (std::is_copy_constructible_v<Allocator>)
+		{
+			return allocator;
+		}
+		else
+		{
+			return Allocator();
+		}
+	}
+
+	// A moved container takes the allocator along, unless the allocator can not be moved like an inline buffer,
+	// then it gets a fresh instance and the elements are moved instead
+	template<typename Allocator>
+	Allocator SelectMovedAllocator(Allocator& allocator)
+	{
+		if constexpr (std::is_move_constructible_v<Allocator>)
+		{
+			return std::move(allocator);
+		}
+		else
+		{
+			return Allocator();
+		}
+	}
 };
 
 #endif // __WTR_TYPETRAITS_H__
\ No newline at end of file